@@ -66,6 +66,9 @@ class arp_hdr_class extends hdr_class; // {
   rand bit [7:0]         dpa[];
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
                                                                                
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit               arp_htype_eth  = 1'b1;
@@ -145,11 +148,12 @@ class arp_hdr_class extends hdr_class; // {
   task pack_hdr(ref   bit [7:0] pkt [],
                 ref   int       index,
                 input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     int tmp_idx;
     pack_vec = {htype, ptype, hlen, plen, opcode};
-    harray.pack_bit(pkt, pack_vec, index, 64);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 64);
     tmp_idx = index/8;
     harray.pack_array_8(sha, pkt, tmp_idx);
     harray.pack_array_8(spa, pkt, tmp_idx);
@@ -157,8 +161,11 @@ class arp_hdr_class extends hdr_class; // {
     harray.pack_array_8(dpa, pkt, tmp_idx);
     index = tmp_idx * 8;
     `else
-    hdr = {>>{htype, ptype, hlen, plen, opcode, sha, spa, dha, dpa}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({htype, ptype, hlen, plen, opcode});
+    harray.pack_array_8 (sha, pkt, index);
+    harray.pack_array_8 (spa, pkt, index);
+    harray.pack_array_8 (dha, pkt, index);
+    harray.pack_array_8 (dpa, pkt, index);
     `endif
     // pack next hdr
     if (~last_pack)
@@ -168,6 +175,7 @@ class arp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -175,15 +183,15 @@ class arp_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {htype, ptype, hlen, plen, opcode} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{htype, ptype, hlen, plen, opcode}} = hdr;
+    `UNPACK_FLDS({htype, ptype, hlen, plen, opcode}, hdr_len);
     `endif
     harray.copy_array (pkt, sha, index, hlen);
     harray.copy_array (pkt, spa, index, plen);
@@ -207,9 +215,7 @@ class arp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -167,6 +167,9 @@ class bth_hdr_class extends hdr_class; // {
   rand bit [31:0]         ieth_hdr;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [415:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
   rand bit [95:0]         bth_hdr;
   rand bit [31:0]         rdeth_hdr;
   rand bit [63:0]         deth_hdr;
@@ -314,13 +317,14 @@ class bth_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     case (opcode) // { 
       8'b00000011 : pack_vec = {bth_hdr, immdt_hdr};
       8'b00000101 : pack_vec = {bth_hdr, immdt_hdr};
       8'b00000110 : pack_vec = {bth_hdr, reth_hdr};
-      8'b00001001 : pack_vec = {bth_hdr, immdt_hdr}
+      8'b00001001 : pack_vec = {bth_hdr, immdt_hdr};
       8'b00001010 : pack_vec = {bth_hdr, reth_hdr};
       8'b00001011 : pack_vec = {bth_hdr, reth_hdr, immdt_hdr};
       8'b00001100 : pack_vec = {bth_hdr, reth_hdr};
@@ -366,59 +370,58 @@ class bth_hdr_class extends hdr_class; // {
       8'b00010111 : pack_vec = {bth_hdr, ieth_hdr};
       default     : pack_vec = bth_hdr;
     endcase // }
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
     case (opcode) // { 
-      8'b00000011 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00000101 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00000110 : hdr = {>>{bth_hdr, reth_hdr}};
-      8'b00001001 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00001010 : hdr = {>>{bth_hdr, reth_hdr}};
-      8'b00001011 : hdr = {>>{bth_hdr, reth_hdr, immdt_hdr}};
-      8'b00001100 : hdr = {>>{bth_hdr, reth_hdr}}; 
-      8'b00001101 : hdr = {>>{bth_hdr, aeth_hdr}};
-      8'b00001111 : hdr = {>>{bth_hdr, aeth_hdr}};
-      8'b00010000 : hdr = {>>{bth_hdr, aeth_hdr}};
-      8'b00010001 : hdr = {>>{bth_hdr, aeth_hdr}}; 
-      8'b00010010 : hdr = {>>{bth_hdr, aeth_hdr , atomicacketh_hdr}};
-      8'b00010011 : hdr = {>>{bth_hdr, atomiceth_hdr}};
-      8'b00010100 : hdr = {>>{bth_hdr, atomiceth_hdr}};
-      8'b00010110 : hdr = {>>{bth_hdr, ieth_hdr}};
-      8'b00010111 : hdr = {>>{bth_hdr, ieth_hdr}};
-      8'b00100011 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00100101 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00100110 : hdr = {>>{bth_hdr, reth_hdr}};
-      8'b00101001 : hdr = {>>{bth_hdr, immdt_hdr}};
-      8'b00101010 : hdr = {>>{bth_hdr, reth_hdr}};
-      8'b00101011 : hdr = {>>{bth_hdr, reth_hdr , immdt_hdr}};
-      8'b01000000 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01000001 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01000010 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01000011 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr , immdt_hdr}};
-      8'b01000100 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01000101 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, immdt_hdr}};
-      8'b01000110 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, reth_hdr}};
-      8'b01000111 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01001000 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr}};
-      8'b01001001 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, immdt_hdr}};
-      8'b01001010 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, reth_hdr}};
-      8'b01001011 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, reth_hdr , immdt_hdr}};
-      8'b01001100 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, reth_hdr}}; 
-      8'b01001101 : hdr = {>>{bth_hdr, rdeth_hdr, aeth_hdr}};
-      8'b01001110 : hdr = {>>{bth_hdr, rdeth_hdr}};
-      8'b01001111 : hdr = {>>{bth_hdr, rdeth_hdr, aeth_hdr}};
-      8'b01010000 : hdr = {>>{bth_hdr, rdeth_hdr, aeth_hdr}};
-      8'b01010001 : hdr = {>>{bth_hdr, rdeth_hdr, aeth_hdr}}; 
-      8'b01010010 : hdr = {>>{bth_hdr, rdeth_hdr, aeth_hdr, atomicacketh_hdr}}; 
-      8'b01010011 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}}; 
-      8'b01010100 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}}; 
-      8'b01010101 : hdr = {>>{bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}}; 
-      8'b01100100 : hdr = {>>{bth_hdr, deth_hdr}};
-      8'b01100101 : hdr = {>>{bth_hdr, deth_hdr , immdt_hdr}};
-      8'b00010111 : hdr = {>>{bth_hdr, ieth_hdr}};
-      default     : hdr = {>>{bth_hdr}};
+      8'b00000011 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00000101 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00000110 : `PACK_FLDS({bth_hdr, reth_hdr});
+      8'b00001001 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00001010 : `PACK_FLDS({bth_hdr, reth_hdr});
+      8'b00001011 : `PACK_FLDS({bth_hdr, reth_hdr, immdt_hdr});
+      8'b00001100 : `PACK_FLDS({bth_hdr, reth_hdr}); 
+      8'b00001101 : `PACK_FLDS({bth_hdr, aeth_hdr});
+      8'b00001111 : `PACK_FLDS({bth_hdr, aeth_hdr});
+      8'b00010000 : `PACK_FLDS({bth_hdr, aeth_hdr});
+      8'b00010001 : `PACK_FLDS({bth_hdr, aeth_hdr}); 
+      8'b00010010 : `PACK_FLDS({bth_hdr, aeth_hdr , atomicacketh_hdr});
+      8'b00010011 : `PACK_FLDS({bth_hdr, atomiceth_hdr});
+      8'b00010100 : `PACK_FLDS({bth_hdr, atomiceth_hdr});
+      8'b00010110 : `PACK_FLDS({bth_hdr, ieth_hdr});
+      8'b00010111 : `PACK_FLDS({bth_hdr, ieth_hdr});
+      8'b00100011 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00100101 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00100110 : `PACK_FLDS({bth_hdr, reth_hdr});
+      8'b00101001 : `PACK_FLDS({bth_hdr, immdt_hdr});
+      8'b00101010 : `PACK_FLDS({bth_hdr, reth_hdr});
+      8'b00101011 : `PACK_FLDS({bth_hdr, reth_hdr , immdt_hdr});
+      8'b01000000 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01000001 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01000010 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01000011 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr , immdt_hdr});
+      8'b01000100 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01000101 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, immdt_hdr});
+      8'b01000110 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, reth_hdr});
+      8'b01000111 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01001000 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr});
+      8'b01001001 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, immdt_hdr});
+      8'b01001010 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, reth_hdr});
+      8'b01001011 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, reth_hdr , immdt_hdr});
+      8'b01001100 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, reth_hdr}); 
+      8'b01001101 : `PACK_FLDS({bth_hdr, rdeth_hdr, aeth_hdr});
+      8'b01001110 : `PACK_FLDS({bth_hdr, rdeth_hdr});
+      8'b01001111 : `PACK_FLDS({bth_hdr, rdeth_hdr, aeth_hdr});
+      8'b01010000 : `PACK_FLDS({bth_hdr, rdeth_hdr, aeth_hdr});
+      8'b01010001 : `PACK_FLDS({bth_hdr, rdeth_hdr, aeth_hdr}); 
+      8'b01010010 : `PACK_FLDS({bth_hdr, rdeth_hdr, aeth_hdr, atomicacketh_hdr}); 
+      8'b01010011 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}); 
+      8'b01010100 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}); 
+      8'b01010101 : `PACK_FLDS({bth_hdr, rdeth_hdr, deth_hdr, atomiceth_hdr}); 
+      8'b01100100 : `PACK_FLDS({bth_hdr, deth_hdr});
+      8'b01100101 : `PACK_FLDS({bth_hdr, deth_hdr , immdt_hdr});
+      8'b00010111 : `PACK_FLDS({bth_hdr, ieth_hdr});
+      default     : `PACK_FLDS({bth_hdr});
     endcase // }
-    harray.pack_array_8 (hdr, pkt, index);
     `endif
     // pack next hdr
     if (~last_pack)
@@ -428,6 +431,7 @@ class bth_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -435,6 +439,7 @@ class bth_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     bit [7:0]  op_code;
     update_len (index, pkt.size, bth_hdr_len);
@@ -491,7 +496,7 @@ class bth_hdr_class extends hdr_class; // {
     endcase // }
     // unpack class members
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     case (op_code) // { 
       8'b00000011 : {opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr} = pack_vec;
       8'b00000101 : {opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr} = pack_vec;
@@ -543,56 +548,55 @@ class bth_hdr_class extends hdr_class; // {
       default     : {opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn} = pack_vec;
     endcase // } 
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
     case (op_code) // { 
-      8'b00000011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00000101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00000110 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b00001001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00001010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b00001011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen, immdt_hdr}} = hdr;
-      8'b00001100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}} = hdr; 
-      8'b00001101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}} = hdr;
-      8'b00001111 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}} = hdr;
-      8'b00010000 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}} = hdr;
-      8'b00010001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}} = hdr; 
-      8'b00010010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn , atomicacketh_hdr}} = hdr;
-      8'b00010011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_aeth, r_key_aeth, swapdt, cmprdt}} = hdr;
-      8'b00010100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_aeth, r_key_aeth, swapdt, cmprdt}} = hdr;
-      8'b00010110 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}} = hdr;
-      8'b00010111 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}} = hdr;
-      8'b00100011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00100101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00100110 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b00101001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}} = hdr;
-      8'b00101010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b00101011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen , immdt_hdr}} = hdr;
-      8'b01000000 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01000001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01000010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01000011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP , immdt_hdr}} = hdr;
-      8'b01000100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01000101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, immdt_hdr}} = hdr;
-      8'b01000110 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b01000111 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01001000 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01001001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, immdt_hdr}} = hdr;
-      8'b01001010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}} = hdr;
-      8'b01001011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen , immdt_hdr}} = hdr;
-      8'b01001100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}} = hdr; 
-      8'b01001101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}} = hdr;
-      8'b01001110 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt}} = hdr;
-      8'b01001111 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}} = hdr;
-      8'b01010000 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}} = hdr;
-      8'b01010001 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}} = hdr; 
-      8'b01010010 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn, atomicacketh_hdr}} = hdr; 
-      8'b01010011 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}} = hdr; 
-      8'b01010100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}} = hdr; 
-      8'b01010101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}} = hdr; 
-      8'b01100100 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, q_key, rsvd_deth, srcQP}} = hdr;
-      8'b01100101 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, q_key, rsvd_deth, srcQP , immdt_hdr}} = hdr;
-      8'b00010111 : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}} = hdr;
-      default     : {>>{opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn}} = hdr;
+      8'b00000011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00000101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00000110 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b00001001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00001010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b00001011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen, immdt_hdr}, hdr_len);
+      8'b00001100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}, hdr_len); 
+      8'b00001101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}, hdr_len);
+      8'b00001111 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}, hdr_len);
+      8'b00010000 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}, hdr_len);
+      8'b00010001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn}, hdr_len); 
+      8'b00010010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, syndrom, msn , atomicacketh_hdr}, hdr_len);
+      8'b00010011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_aeth, r_key_aeth, swapdt, cmprdt}, hdr_len);
+      8'b00010100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_aeth, r_key_aeth, swapdt, cmprdt}, hdr_len);
+      8'b00010110 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}, hdr_len);
+      8'b00010111 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}, hdr_len);
+      8'b00100011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00100101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00100110 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b00101001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, immdt_hdr}, hdr_len);
+      8'b00101010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b00101011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, va_reth, r_key_reth, dmalen , immdt_hdr}, hdr_len);
+      8'b01000000 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01000001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01000010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01000011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP , immdt_hdr}, hdr_len);
+      8'b01000100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01000101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, immdt_hdr}, hdr_len);
+      8'b01000110 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b01000111 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01001000 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01001001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, immdt_hdr}, hdr_len);
+      8'b01001010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}, hdr_len);
+      8'b01001011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen , immdt_hdr}, hdr_len);
+      8'b01001100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_reth, r_key_reth, dmalen}, hdr_len); 
+      8'b01001101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}, hdr_len);
+      8'b01001110 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt}, hdr_len);
+      8'b01001111 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}, hdr_len);
+      8'b01010000 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}, hdr_len);
+      8'b01010001 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn}, hdr_len); 
+      8'b01010010 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, syndrom, msn, atomicacketh_hdr}, hdr_len); 
+      8'b01010011 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}, hdr_len); 
+      8'b01010100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}, hdr_len); 
+      8'b01010101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, rsvd_rdeth, EEcnxt, q_key, rsvd_deth, srcQP, va_aeth, r_key_aeth, swapdt, cmprdt}, hdr_len); 
+      8'b01100100 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, q_key, rsvd_deth, srcQP}, hdr_len);
+      8'b01100101 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, q_key, rsvd_deth, srcQP , immdt_hdr}, hdr_len);
+      8'b00010111 : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn, ieth_hdr}, hdr_len);
+      default     : `UNPACK_FLDS({opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn}, hdr_len);
     endcase // } 
     `endif
     bth_hdr       = {opcode, S, M, padcnt, tver, p_key, rsvd0, destQP, A, rsvd1, psn};
@@ -618,9 +622,7 @@ class bth_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -70,6 +70,9 @@ class cnm_hdr_class extends hdr_class; // {
   rand bit [15:0]    encap_len;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [191:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           corrupt_cnm_ver      = 1'b0;
@@ -126,13 +129,13 @@ class cnm_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -142,6 +145,7 @@ class cnm_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -149,15 +153,15 @@ class cnm_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class  lcl_class;
     // unpack class members
     update_len (index, pkt.size, 24);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len}} = hdr;
+    `UNPACK_FLDS({cnm_ver, rsvd, qfeedback, cpid, cnmqoffset, cnmqdelta, encap_priority, encap_da, encap_len}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -176,9 +180,7 @@ class cnm_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
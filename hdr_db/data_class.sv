@@ -30,10 +30,13 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 class data_class extends hdr_class; // {
 
   // ~~~~~~~~~~ Class members ~~~~~~~~~~
-  rand bit [7:0]  data [];
+  rand bit [7:0]  data [];     // solved only if use_solver, else filled in post_randomize
   rand bit [15:0] data_len;
+  rand bit [63:0] prng_seed;   // seeds harray PRNG for data_pattern "RND"
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+       bit        is_view = 1'b0; // data is still a view at view_off of plib pkt (see view_byte)
+       int        view_off;
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit        mpls_chk_en = 1'b1; //  check to make sure first data nibble is not 0, 4 or 6
@@ -59,7 +62,7 @@ class data_class extends hdr_class; // {
   constraint legal_data_len
   {
     data_len inside { [16'd0 : `MAX_PLEN] }; // data_len can't be -ve
-    data.size == data_len;
+    use_solver -> data.size == data_len;
   }
 
   // ~~~~~~~~~~ Task begins ~~~~~~~~~~
@@ -73,10 +76,25 @@ class data_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  // data is kept out of solver unless use_solver is set (for E.g. user
+  // constraints on data in data_hdr_user_constraint)
+  function void pre_randomize (); // {
+    super.pre_randomize();
+    data.rand_mode (use_solver);
+  endfunction : pre_randomize // }
+
   function void post_randomize (); // {
     bit [7:0] tmp_data;
     super.post_randomize();
-    if (harray.data_pattern != "RND")
+    is_view = 1'b0;
+    if (~use_solver)
+    begin // {
+        // payload is kept out of solver, fill it in bulk
+        data = new [data_len];
+        harray.seed_prng (prng_seed, 1'b0);
+        harray.fill_array (data);
+    end // }
+    else if (harray.data_pattern != "RND")
         harray.fill_array (data);
     if (mpls_chk_en)
     begin // {
@@ -97,12 +115,26 @@ class data_class extends hdr_class; // {
     end // }
   endfunction : post_randomize // }
 
+  // data_len is picked by pktlib_main_class::fast_randomize to meet plen
+  function bit fast_randomize (); // {
+    prng_seed = {$urandom, $urandom};
+    return 1'b1;
+  endfunction : fast_randomize // }
+
+  function void fast_post_len (); // {
+    post_randomize ();
+  endfunction : fast_post_len // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
-    // pack class members
+    `PROF_BEGIN
     `ifdef SVFNYI_0
     int tmp_idx;
+    `endif
+    // pack class members
+    fetch_view ();
+    `ifdef SVFNYI_0
     tmp_idx = index/8;
     harray.pack_array_8 (data, pkt, tmp_idx);
     index = tmp_idx * 8;
@@ -117,6 +149,7 @@ class data_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }          
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -124,6 +157,7 @@ class data_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class  lcl_class;
     int        i;
     // unpack class members
@@ -135,7 +169,19 @@ class data_class extends hdr_class; // {
         hdr_len   = 0;
     data_len      = hdr_len;
     total_hdr_len = hdr_len;
-    harray.copy_array (pkt, data, index, hdr_len);
+    if (plib.data_view)
+    begin // {
+        // keep payload as a view in pkt, it is copied only when needed
+        is_view   = 1'b1;
+        view_off  = index;
+        data      = null_a;
+        index    += hdr_len;
+    end // }
+    else
+    begin // {
+        is_view   = 1'b0;
+        harray.copy_array (pkt, data, index, hdr_len);
+    end // }
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
     begin // {
@@ -150,16 +196,35 @@ class data_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
+  function void fetch_view (); // {
+    if (is_view)
+    begin // {
+        data    = new [data_len];
+        foreach (data[i])
+            data[i] = plib.view_byte (view_off + i);
+        is_view = 1'b0;
+    end // }
+  endfunction : fetch_view // }
+
+  // function to get data size, without fetching a view
+  function int data_sz (); // {
+    return (is_view ? data_len : data.size);
+  endfunction : data_sz // }
+
+  // function to get data[i], from plib pkt if data is still a view
+  function bit [7:0] data_byte (int i); // {
+    return (is_view ? plib.view_byte (view_off + i) : data[i]);
+  endfunction : data_byte // }
+
   task cpy_hdr (hdr_class cpy_cls,
                 bit       last_cpy = 1'b0); // {
     data_class lcl;
     super.cpy_hdr (cpy_cls);
     $cast (lcl, cpy_cls);
+    lcl.fetch_view ();
     this.data        = lcl.data;
     this.data_len    = lcl.data_len;
     this.mpls_chk_en = lcl.mpls_chk_en;
@@ -176,24 +241,29 @@ class data_class extends hdr_class; // {
     $cast (lcl, cmp_cls);
     if ((mode == COMPARE_FULL) | (mode == DISPLAY_FULL))
     begin // {
+        // full display needs data arrays, other modes (FIELD_MAP) read views in place
+        fetch_view ();
+        lcl.fetch_view ();
         hdis.display_fld (mode, hdr_name, STRING,  DEF, 000, "", 0, 0, null_a, null_a, "~~~~~~~~~~ Class members ~~~~~~~~~~");
         hdis.display_fld (mode, hdr_name, ARRAY,   DEF, 000, "data", 0, 0, data, lcl.data);
     end // }
     else
     begin // {
-        if (data.size > 4)
-            $sformat(sample_data, "data => %x %x %x %x ..", data[0], data[1], data[2], data[3]);
+        if (mode == FIELD_MAP)
+            sample_data = "";
+        else if (data_sz () > 4)
+            $sformat(sample_data, "data => %x %x %x %x ..", data_byte (0), data_byte (1), data_byte (2), data_byte (3));
         else
         begin // {
-            case (data.size) // {
-              4 : $sformat(sample_data, "data => %x %x %x %x ", data[0], data[1], data[2], data[3]);
-              3 : $sformat(sample_data, "data => %x %x %x", data[0], data[1], data[2]);
-              2 : $sformat(sample_data, "data => %x %x", data[0], data[1]);
-              1 : $sformat(sample_data, "data => %x", data[0]);
+            case (data_sz ()) // {
+              4 : $sformat(sample_data, "data => %x %x %x %x ", data_byte (0), data_byte (1), data_byte (2), data_byte (3));
+              3 : $sformat(sample_data, "data => %x %x %x", data_byte (0), data_byte (1), data_byte (2));
+              2 : $sformat(sample_data, "data => %x %x", data_byte (0), data_byte (1));
+              1 : $sformat(sample_data, "data => %x", data_byte (0));
               0 : $sformat(sample_data, "data => EMPTY");
             endcase // }
         end // }
-        hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "data_len", data.size, lcl.data.size, null_a, null_a, sample_data);
+        hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "data_len", data_sz (), lcl.data_sz (), null_a, null_a, sample_data);
         hdis.index += hdr_len*8;
     end // }
     if ((mode == DISPLAY_FULL) | (mode == COMPARE_FULL))
@@ -74,6 +74,9 @@ class dphy_hdr_class extends hdr_class; // {
   rand bit [5:0]     ecc;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [31:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           cal_wc           = 1'b1;
@@ -140,6 +143,7 @@ class dphy_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     bit [15:0] tmp_wc;
     bit [25:0] ecc_data_in;
     // finf if it is DPHY Short pkt 
@@ -154,10 +158,9 @@ class dphy_hdr_class extends hdr_class; // {
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {di,tmp_wc,vcx,ecc};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{di,tmp_wc,vcx,ecc}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({di,tmp_wc,vcx,ecc});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -167,6 +170,7 @@ class dphy_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -174,17 +178,17 @@ class dphy_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     bit [25:0] ecc_data_in;
     bit[5:0]   ecc_cal;
     // unpack class members
     update_len (index, pkt.size, 4);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {di,wc,vcx,ecc} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{di,wc,vcx,ecc}} = hdr;
+    `UNPACK_FLDS({di,wc,vcx,ecc}, hdr_len);
     `endif
     sph            = wc;
     ecc_data_in    = {vcx,wc,di};
@@ -213,9 +217,7 @@ class dphy_hdr_class extends hdr_class; // {
         cal_dphy_spkt;
     end // }
 
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   // Calculate dphy_spkt
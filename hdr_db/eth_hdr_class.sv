@@ -48,6 +48,9 @@ class eth_hdr_class extends hdr_class; // {
   rand bit [15:0] etype;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [111:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit        is_multi_da = 1'b0; 
@@ -96,16 +99,29 @@ class eth_hdr_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  function bit fast_randomize (); // {
+    da      = {$urandom, $urandom};
+    sa      = {$urandom, $urandom};
+    if (is_multi_da)
+        da[40] = 1'b1;
+    if (is_broad_da)
+        da = 48'hffffffffffff;
+    etype   = get_fast_etype (nxt_hdr.hid);
+    hdr_len = 14;
+    trl_len = 0;
+    return 1'b1;
+  endfunction : fast_randomize // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {da, sa, etype};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{da, sa, etype}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({da, sa, etype});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -115,22 +131,32 @@ class eth_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 14))
+        return -1;
+    nxt_hid = get_hid_from_etype ({pkt[index+12], pkt[index+13]});
+    return 14;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len(index, pkt.size, 14, 0);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {da, sa, etype} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{da, sa, etype}} = hdr;
+    `UNPACK_FLDS({da, sa, etype}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -149,9 +175,7 @@ class eth_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -75,6 +75,9 @@ class fc_hdr_class extends hdr_class; // {
   rand bit [31:0]         fcrc;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [191:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit               cal_n_add_fcrc = 1'b1;
@@ -111,13 +114,13 @@ class fc_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -136,16 +139,16 @@ class fc_hdr_class extends hdr_class; // {
             // pack class members
             `ifdef SVFNYI_0
             pack_vec = fcrc;
-            harray.pack_bit (pkt, pack_vec, index, trl_len*8);
+            pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, trl_len*8);
             `else
-            hdr = {>>{fcrc}};
-            harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({fcrc});
             `endif
             `ifdef DEBUG_PKTLIB
             $display ("    pkt_lib : Packing %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index);
             `endif
        end // }
    end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -153,6 +156,7 @@ class fc_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     if (pkt_format == FC) // trl_len = 0, as toh_class will take care of CRC
@@ -160,11 +164,10 @@ class fc_hdr_class extends hdr_class; // {
     else
         update_len(index, pkt.size, 24, 4);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter}} = hdr;
+    `UNPACK_FLDS({r_ctl, d_id, cs_ctl_pri, s_id, fc_type, f_ctl, seq_id, df_ctl, seq_cnt, ox_id, rx_id, fc_parameter}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -183,23 +186,20 @@ class fc_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
     // unpack class members - trailer
     if (trl_len != 0)
     begin // {
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, trl_len);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, trl_len);
         fcrc = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, trl_len);
-        {>>{fcrc}} = hdr;
+        `UNPACK_FLDS({fcrc}, trl_len);
         `endif
         `ifdef DEBUG_PKTLIB
         $display ("    pkt_lib : Unpacking %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index); 
         `endif
     end // }
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
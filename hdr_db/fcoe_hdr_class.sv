@@ -80,6 +80,9 @@ class fcoe_hdr_class extends hdr_class; // {
   rand bit [23:0]        rsvd1;            
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [111:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit               corrupt_fcoe_ver  = 1'b0;
@@ -151,19 +154,19 @@ class fcoe_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     if (timestamp_format)
         pack_vec = {fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp};
     else
         pack_vec = {fcoe_ver, rsvd_0, sof};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
     if (timestamp_format)
-        hdr = {>>{fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp}};
+        `PACK_FLDS({fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp});
     else
-        hdr = {>>{fcoe_ver, rsvd_0, sof}};
-    harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({fcoe_ver, rsvd_0, sof});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -177,14 +180,14 @@ class fcoe_hdr_class extends hdr_class; // {
     // pack class members trailer
     `ifdef SVFNYI_0
     pack_vec = {eof, rsvd1};
-    harray.pack_bit (pkt, pack_vec, index, trl_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, trl_len*8);
     `else
-    hdr = {>>{eof, rsvd1}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({eof, rsvd1});
     `endif
     `ifdef DEBUG_PKTLIB
     $display ("    pkt_lib : Packing %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index); 
     `endif
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -192,21 +195,21 @@ class fcoe_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len(index, pkt.size, 14, 4);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     if (timestamp_format)
         {fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp} = pack_vec;
     else
         {fcoe_ver, rsvd_0, sof} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
     if (timestamp_format)
-        {>>{fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp}} = hdr;
+        `UNPACK_FLDS({fcoe_ver, fcoe_type, sof, tv, rsvd0, timestamp}, hdr_len);
     else
-        {>>{fcoe_ver, rsvd_0, sof}} = hdr;
+        `UNPACK_FLDS({fcoe_ver, rsvd_0, sof}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -225,21 +228,18 @@ class fcoe_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
     // unpack class members
     start_off = index;
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, trl_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, trl_len);
     {eof, rsvd1} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, trl_len);
-    {>>{eof, rsvd1}} = hdr;
+    `UNPACK_FLDS({eof, rsvd1}, trl_len);
     `endif
     `ifdef DEBUG_PKTLIB
     $display ("    pkt_lib : Unpacking %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index); 
     `endif
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
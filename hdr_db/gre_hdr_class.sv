@@ -99,6 +99,9 @@ class gre_hdr_class extends hdr_class; // {
   rand bit [31:0]    ack_number;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [31:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
   rand  int          chkoff_len;
   rand  int          key_len;
   rand  int          seq_len;
@@ -236,24 +239,23 @@ class gre_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int gre_idx;
     gre_idx = index;
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {C, R, K, S, s, recur, A, flags, version, etype};
-    harray.pack_bit (pkt, pack_vec, index, 32);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
     `else
-    hdr = {>>{C, R, K, S, s, recur, A, flags, version, etype}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({C, R, K, S, s, recur, A, flags, version, etype});
     `endif
     if (C | R)
     begin // {
         `ifdef SVFNYI_0
         pack_vec = {checksum, offset};
-        harray.pack_bit (pkt, pack_vec, index, 32);
+        pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
         `else
-        hdr = {>>{checksum, offset}};
-        harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({checksum, offset});
         `endif
     end // }
     if (K)
@@ -262,30 +264,27 @@ class gre_hdr_class extends hdr_class; // {
         begin // {
             `ifdef SVFNYI_0
             pack_vec = {payload_length, call_id};
-            harray.pack_bit (pkt, pack_vec, index, 32);
+            pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
             `else
-            hdr = {>>{payload_length, call_id}};
-            harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({payload_length, call_id});
             `endif
         end // }
         else if ((etype == eth_etype) | implement_nvgre)
         begin // {
             `ifdef SVFNYI_0
             pack_vec = {tni, reserved};
-            harray.pack_bit (pkt, pack_vec, index, 32);
+            pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
             `else
-            hdr = {>>{tni, reserved}};
-            harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({tni, reserved});
             `endif
         end // }
         else
         begin // {
             `ifdef SVFNYI_0
             pack_vec = key;
-            harray.pack_bit (pkt, pack_vec, index, 32);
+            pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
             `else
-            hdr = {>>{key}};
-            harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({key});
             `endif
         end // }
     end // }
@@ -293,20 +292,18 @@ class gre_hdr_class extends hdr_class; // {
     begin // {
         `ifdef SVFNYI_0
         pack_vec = sequence_number;
-        harray.pack_bit (pkt, pack_vec, index, 32);
+        pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
         `else
-        hdr = {>>{sequence_number}};
-        harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({sequence_number});
         `endif
     end // }
     if (A)
     begin // {
         `ifdef SVFNYI_0
         pack_vec = ack_number;
-        harray.pack_bit (pkt, pack_vec, index, 32);
+        pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
         `else
-        hdr = {>>{ack_number}};
-        harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({ack_number});
         `endif
     end // }
     // pack next hdr
@@ -319,13 +316,26 @@ class gre_hdr_class extends hdr_class; // {
     end // }
     if (~last_pack & (C | R))
         post_pack (pkt, gre_idx);
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 4))
+        return -1;
+    nxt_hid = get_hid_from_etype ({pkt[index+2], pkt[index+3]});
+    // C|R, K, S (byte 0) and A (byte 1) add 4B each
+    return (4 + ((pkt[index][7] | pkt[index][6]) * 4) + (pkt[index][5] * 4) +
+                  (pkt[index][4] * 4) + (pkt[index+1][7] * 4));
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len(index, pkt.size, 4);
@@ -334,28 +344,26 @@ class gre_hdr_class extends hdr_class; // {
     seq_len       = 0;
     ack_len       = 0;
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, 4);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
     {C, R, K, S, s, recur, A, flags, version, etype} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{C, R, K, S, s, recur, A, flags, version, etype}} = hdr;
+    `UNPACK_FLDS({C, R, K, S, s, recur, A, flags, version, etype}, hdr_len);
     `endif
     if (C | R)
     begin // {
         chkoff_len = 4;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 4);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
         {checksum, offset} = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, chkoff_len);
-        {>>{checksum, offset}} = hdr;
+        `UNPACK_FLDS({checksum, offset}, chkoff_len);
         `endif
     end // }
     if (K)
     begin // {
         key_len = 4;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 4);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
         if ((version == 1) | implement_rfc2637)
             {payload_length, call_id} = pack_vec;
         else if ((etype == eth_etype) | implement_nvgre)
@@ -363,35 +371,32 @@ class gre_hdr_class extends hdr_class; // {
         else
             key = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, key_len);
         if ((version == 1) | implement_rfc2637)
-            {>>{payload_length, call_id}} = hdr;
+            `UNPACK_FLDS({payload_length, call_id}, key_len);
         else if ((etype == eth_etype) | implement_nvgre)
-            {>>{tni, reserved}} = hdr;
+            `UNPACK_FLDS({tni, reserved}, key_len);
         else
-            {>>{key}} = hdr;
+            `UNPACK_FLDS({key}, key_len);
         `endif
     end // }
     if (S)
     begin // {
         seq_len = 4;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 4);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
         sequence_number = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, seq_len);
-        {>>{sequence_number}} = hdr;
+        `UNPACK_FLDS({sequence_number}, seq_len);
         `endif
     end // }
     if (A)
     begin // {
         ack_len = 4;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 4);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
         ack_number = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, ack_len);
-        {>>{ack_number}} = hdr;
+        `UNPACK_FLDS({ack_number}, ack_len);
         `endif
     end // }
     hdr_len += chkoff_len + key_len + seq_len + ack_len;
@@ -411,36 +416,20 @@ class gre_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref bit [7:0] pkt [],
                           int       gre_idx); // {
-    bit [7:0] chksm_data [];
-    int       idx;
-    // Calulate udp_chksm, corrupt it if asked
+    `PROF_BEGIN
+    // Calulate gre chksm on pkt directly, corrupt it if asked
     if (cal_chksm)
-    begin // {
-        idx = gre_idx;
-        harray.copy_array(pkt, chksm_data, idx, (pkt.size - gre_idx));
-        if (chksm_data.size/2 != 0)
-        begin // {
-            chksm_data                      = new [chksm_data.size + 1] (chksm_data);
-            chksm_data [chksm_data.size -1] = 8'h00;
-        end // }
-        checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_chksm, corrupt_chksm_msk);
-        pack_hdr (pkt, gre_idx, 1'b1);
-    end // }
-    else
-    begin // {
-        if (corrupt_chksm)
-        begin // {
-            checksum ^= corrupt_chksm_msk;
-            pack_hdr (pkt, gre_idx, 1'b1);
-        end // }
-    end // }
+        checksum = crc_chksm.chksm16_slice(pkt, gre_idx, (pkt.size - gre_idx), corrupt_chksm, corrupt_chksm_msk);
+    else if (corrupt_chksm)
+        checksum ^= corrupt_chksm_msk;
+    if (cal_chksm | corrupt_chksm)
+        {pkt[gre_idx+4], pkt[gre_idx+5]} = checksum;
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
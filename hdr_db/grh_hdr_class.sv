@@ -63,10 +63,9 @@ class grh_hdr_class extends hdr_class; // {
   rand bit [127:0]        dgid;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-  local bit [7:0]         chksm_data [];
-  local int               chksm_idx;
-  local bit [7:0]         pseudo_chksm_data [];
-  local int               pseudo_chksm_idx;
+  `ifdef SVFNYI_0
+         bit [319:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
         bit [15:0]        pseudo_chksm;
   rand  bit [15:0]        icrc_sz;
 
@@ -132,13 +131,13 @@ class grh_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid});
     `endif
     cal_pseudo_chksm;
     // pack next hdr
@@ -149,6 +148,7 @@ class grh_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -156,15 +156,15 @@ class grh_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 40);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid}} = hdr;
+    `UNPACK_FLDS({ipver, tclass, flow_label, payload_len, protocol, hoplmt, sgid, dgid}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -183,9 +183,7 @@ class grh_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -203,8 +201,6 @@ class grh_hdr_class extends hdr_class; // {
     this.sgid                = lcl.sgid;
     this.dgid                = lcl.dgid;
     // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-    this.chksm_data          = lcl.chksm_data;
-    this.chksm_idx           = lcl.chksm_idx;
     this.pseudo_chksm        = lcl.pseudo_chksm;
     this.icrc_sz             = lcl.icrc_sz;
     // ~~~~~~~~~~ Control variables ~~~~~~~~~~
@@ -243,10 +239,6 @@ class grh_hdr_class extends hdr_class; // {
     if ((mode == DISPLAY_FULL) | (mode == COMPARE_FULL))
     begin // {
     display_common_hdr_flds (hdis, lcl, mode); 
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "chksm_data", 0, 0, chksm_data, lcl.chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "chksm_idx", chksm_idx, lcl.chksm_idx);
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "pseudo_chksm_data", 0, 0, pseudo_chksm_data, lcl.pseudo_chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "pseudo_chksm_idx", pseudo_chksm_idx, lcl.pseudo_chksm_idx);
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 016, "pseudo_chksm", pseudo_chksm, lcl.pseudo_chksm);
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 016, "icrc_sz", icrc_sz, lcl.icrc_sz);
     end // }
@@ -256,16 +248,12 @@ class grh_hdr_class extends hdr_class; // {
 
   // calculate pseudo ipv6 header checksum. It may be required for UDP or TCP
   task cal_pseudo_chksm (); // {
-    pseudo_chksm_idx  = 0;
-    pseudo_chksm      = 0;
-    `ifdef SVFNYI_0
-    pseudo_chksm_data = new[40];
-    pack_vec          = {32'h0, {8'h0, protocol}, payload_len, sgid, dgid};
-    harray.pack_bit(pseudo_chksm_data, pack_vec, pseudo_chksm_idx, 320);
-    `else
-    pseudo_chksm_data = {>>{32'h0, 8'h0, protocol, payload_len, sgid, dgid}}; 
-    `endif
-    pseudo_chksm      = crc_chksm.chksm16(pseudo_chksm_data, pseudo_chksm_data.size(), 0, 0, 16'hFFFF);
+    bit [31:0] sum;
+    // pseudo hdr is summed as integers, {32'h0, 8'h0, protocol, payload_len, sgid, dgid}
+    sum = protocol + payload_len;
+    for (int i = 0; i < 8; i++)
+        sum += sgid[i*16 +: 16] + dgid[i*16 +: 16];
+    pseudo_chksm = ~crc_chksm.chksm16_fold (sum);
   endtask : cal_pseudo_chksm // }
 
 endclass : grh_hdr_class // }
@@ -27,6 +27,26 @@ virtual class hdr_class extends pktlib_object_class; // {
     this.plib = plib;
   endfunction : new // }
 
+  // hdr objects are counted as hdr_class till update_hdr_db, then by hdr
+  // name without inst_no (for E.g. ipv4)
+  function string obj_type (); // {
+    return "hdr_class";
+  endfunction : obj_type // }
+
+  function int obj_bytes (); // {
+    return 256;
+  endfunction : obj_bytes // }
+
+  // randomize fields of this hdr without solver, hdr_len/trl_len included.
+  // Returns 0 if hdr has no solver free path (pktlib falls back to randomize)
+  virtual function bit fast_randomize (); // {
+    return 1'b0;
+  endfunction : fast_randomize // }
+
+  // set fields which depend on total_hdr_len/start_off (used by fast_randomize)
+  virtual function void fast_post_len (); // {
+  endfunction : fast_post_len // }
+
   // pack all the fields of this hdr to input pkt array
   virtual task pack_hdr (ref   bit [7:0] pkt [], 
                          ref   int       index,
@@ -41,6 +61,20 @@ virtual class hdr_class extends pktlib_object_class; // {
                            input bit       last_unpack = 1'b0); // {
   endtask : unpack_hdr // }
 
+  // get hdr_len and nxt hid of this hdr from pkt at index without touching
+  // any hdr field (used by parse_layers). Returns -1 if there is no flat parser
+  virtual function int parse_flat (ref   bit [7:0] pkt [],
+                                   input int       index,
+                                   output int      nxt_hid); // {
+    nxt_hid = DATA_HID;
+    return -1;
+  endfunction : parse_flat // }
+
+  // copy fields left as (offset, length) views into plib pkt by a
+  // data_view unpack in to the hdr's own arrays
+  virtual function void fetch_view (); // {
+  endfunction : fetch_view // }
+
   // display all this hdr fields
   virtual task display_hdr (pktlib_display_class hdis,
                             hdr_class            cmp_cls,
@@ -48,9 +82,9 @@ virtual class hdr_class extends pktlib_object_class; // {
                             bit                  last_display = 1'b0); // {
   endtask : display_hdr // }
 
-  // copy all the fields
-  task cpy_hdr (hdr_class cpy_cls,
-                bit       last_cpy = 1'b0); // {
+  // copy all the fields, of all nxt hdrs too unless last_cpy
+  virtual task cpy_hdr (hdr_class cpy_cls,
+                        bit       last_cpy = 1'b0); // {
     `HDR_INCLUDE_CPY;
   endtask : cpy_hdr // }
 
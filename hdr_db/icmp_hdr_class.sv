@@ -51,6 +51,9 @@ class icmp_hdr_class extends hdr_class; // {
   rand  bit [31:0]    msg_body;   
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
         bit           cal_icmp_chksm         = 1'b1;
@@ -105,37 +108,18 @@ class icmp_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
-    bit [7:0] cdata [];
+    `PROF_BEGIN
     int       icmp_idx;
     // making sure checksum is 0, incase pack_hdr was called before radomization
-    if (~last_pack)
-    begin // {
-        if (cal_icmp_chksm)
-        begin // {
-            checksum = 0;
-            // calculate checksum if its ICMP
-            if (hid === ICMP_HID)
-            begin // {
-                cdata    = new[hdr_len];
-                icmp_idx = 0;
-                pack_hdr (cdata, icmp_idx, 1'b1);
-                checksum = crc_chksm.chksm16(cdata, cdata.size(), 0, corrupt_icmp_chksm, corrupt_icmp_chksm_msk);
-            end // }
-        end // }
-        else if (hid === ICMP_HID)
-        begin // {
-            if (corrupt_icmp_chksm)
-                checksum ^= corrupt_icmp_chksm_msk;
-        end // }
-    end // }
+    if (~last_pack & cal_icmp_chksm)
+        checksum = 0;
     icmp_idx = index;
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {icmp_type, code, checksum, msg_body};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-     hdr = {>>{icmp_type, code, checksum, msg_body}};
-    harray.pack_array_8 (hdr, pkt, index);
+     `PACK_FLDS({icmp_type, code, checksum, msg_body});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -146,8 +130,9 @@ class icmp_hdr_class extends hdr_class; // {
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
     // checksum calulation
-    if (~last_pack & (hid === ICMPV6_HID))
+    if (~last_pack)
         post_pack (pkt, icmp_idx);
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -155,15 +140,15 @@ class icmp_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {icmp_type, code, checksum, msg_body} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{icmp_type, code, checksum, msg_body}} = hdr;
+    `UNPACK_FLDS({icmp_type, code, checksum, msg_body}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -182,58 +167,32 @@ class icmp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref bit [7:0] pkt [],
                       int       icmp_idx); // {
-    bit [7:0]      chksm_data [];
-    bit [15:0]     pseudo_chksm;
-    int            i, idx;
-    ipv4_hdr_class lcl_ip4;
-    ipv6_hdr_class lcl_ip6;
-    // Calulate icmp_chksm, corrupt it if asked
+    `PROF_BEGIN
+    int idx;
+    `ifdef SVFNYI_0
+    idx = icmp_idx/8;
+    `else
+    idx = icmp_idx;
+    `endif
+    // Calulate icmp_chksm on pkt directly, corrupt it if asked
     if (cal_icmp_chksm)
     begin // {
-        for (i = 0; i < this.cfg_id; i++)
-        begin // {
-            if (super.all_hdr[i].hid == IPV4_HID)
-            begin // {
-                lcl_ip4 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip4, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip4.pseudo_chksm;
-            end // }
-            if (super.all_hdr[i].hid == IPV6_HID)
-            begin // {
-                lcl_ip6 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip6, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip6.pseudo_chksm;
-            end // }
-        end // }
-        `ifdef SVFNYI_0
-        idx = icmp_idx/8;
-        `else
-        idx = icmp_idx;
-        `endif
-        harray.copy_array(pkt, chksm_data, idx, (pkt.size - icmp_idx));
-        if (chksm_data.size%2 != 0)
-        begin // {
-            chksm_data                      = new [chksm_data.size + 1] (chksm_data);
-            chksm_data [chksm_data.size -1] = 8'h00;
-        end // }
-        checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_icmp_chksm, corrupt_icmp_chksm_msk, pseudo_chksm);
-        pack_hdr (pkt, icmp_idx, 1'b1);
-    end // }
-    else
-    begin // {
-        if (corrupt_icmp_chksm)
-        begin // {
-            checksum ^= corrupt_icmp_chksm_msk;
-            pack_hdr (pkt, icmp_idx, 1'b1);
-        end // }
+        // ICMP covers only icmp hdr, ICMPV6 covers rest of the pkt and pseudo hdr
+        if (hid === ICMP_HID)
+            checksum = crc_chksm.chksm16_slice(pkt, idx, hdr_len, corrupt_icmp_chksm, corrupt_icmp_chksm_msk);
+        else
+            checksum = crc_chksm.chksm16_slice(pkt, idx, (pkt.size - idx), corrupt_icmp_chksm, corrupt_icmp_chksm_msk, get_pseudo_sum (1'b0));
     end // }
+    else if (corrupt_icmp_chksm)
+        checksum ^= corrupt_icmp_chksm_msk;
+    if (cal_icmp_chksm | corrupt_icmp_chksm)
+        {pkt[idx+2], pkt[idx+3]} = checksum;
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -52,6 +52,9 @@ class igmp_hdr_class extends hdr_class; // {
   rand  bit [31:0]    group_addr;   
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
         bit           cal_igmp_chksm         = 1'b1;
@@ -100,6 +103,7 @@ class igmp_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int       igmp_idx;
     // making sure checksum is 0, incase pack_hdr was called before radomization
     if (~last_pack & cal_igmp_chksm)
@@ -108,10 +112,9 @@ class igmp_hdr_class extends hdr_class; // {
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {igmp_type, max_res_code, checksum, group_addr};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-     hdr = {>>{igmp_type, max_res_code, checksum, group_addr}};
-    harray.pack_array_8 (hdr, pkt, index);
+     `PACK_FLDS({igmp_type, max_res_code, checksum, group_addr});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -124,6 +127,7 @@ class igmp_hdr_class extends hdr_class; // {
     // checksum calulation
     if (~last_pack)
         post_pack (pkt, igmp_idx);
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -131,15 +135,15 @@ class igmp_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {igmp_type, max_res_code, checksum, group_addr} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{igmp_type, max_res_code, checksum, group_addr}} = hdr;
+    `UNPACK_FLDS({igmp_type, max_res_code, checksum, group_addr}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -158,29 +162,20 @@ class igmp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref bit [7:0] pkt [],
                           int       igmp_idx); // {
-    bit [7:0] chksm_data [];
-    // Calulate igmp_chksm, corrupt it if asked
+    `PROF_BEGIN
+    // Calulate igmp_chksm on pkt directly, corrupt it if asked
     if (cal_igmp_chksm)
-    begin // {
-        harray.copy_array(pkt, chksm_data, igmp_idx, (pkt.size - igmp_idx));
-        checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_igmp_chksm, corrupt_igmp_chksm_msk);
-        pack_hdr (pkt, igmp_idx, 1'b1);
-    end // }
-    else
-    begin // {
-        if (corrupt_igmp_chksm)
-        begin // {
-            checksum ^= corrupt_igmp_chksm_msk;
-            pack_hdr (pkt, igmp_idx, 1'b1);
-        end // }
-    end // }
+        checksum = crc_chksm.chksm16_slice(pkt, igmp_idx, (pkt.size - igmp_idx), corrupt_igmp_chksm, corrupt_igmp_chksm_msk);
+    else if (corrupt_igmp_chksm)
+        checksum ^= corrupt_igmp_chksm_msk;
+    if (cal_igmp_chksm | corrupt_igmp_chksm)
+        {pkt[igmp_idx+2], pkt[igmp_idx+3]} = checksum;
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -0,0 +1,248 @@
+/*! \file flow_dpi.c
+ * Contains the DPI-C routine used to extract outer/inner flow keys and a
+ * 64 bit FNV-1a flow hash of a pkt, walking hdrs without any unpack.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <svdpi.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* flow key bytes : {ip_ver, ip_sa[16], ip_da[16], protocol, src_prt[2], dst_prt[2]} */
+#define FLOW_KEY_SZ   38
+#define FLOW_MAX_MPLS 4
+
+  enum { F_DONE, F_ETH, F_VLAN, F_MPLS, F_IPV4, F_IPV6, F_IPV6_EXT,
+         F_GRE, F_UDP, F_TCP, F_VXLAN, F_LISP, F_OTV, F_STT };
+
+  static int flow_from_etype (int etype)
+  {
+    switch (etype)
+    {
+        case 0x8100 : case 0x8200 : case 0x88A8 : return F_VLAN;
+        case 0x8847 : case 0x8848 :               return F_MPLS;
+        case 0x0800 :                             return F_IPV4;
+        case 0x86DD :                             return F_IPV6;
+        case 0x6558 :                             return F_ETH;
+        default     :                             return F_DONE;
+    }
+  }
+
+  static int flow_from_prot (int prot)
+  {
+    switch (prot)
+    {
+        case 0x04 :                           return F_IPV4;
+        case 0x29 :                           return F_IPV6;
+        case 0x00 : case 0x2B : case 0x2C :
+        case 0x3C :                           return F_IPV6_EXT;
+        case 0x2F :                           return F_GRE;
+        case 0x11 :                           return F_UDP;
+        case 0x06 :                           return F_TCP;
+        default   :                           return F_DONE;
+    }
+  }
+
+  static void flow_key_to_sv (const uint8_t *key, svBitVecVal *v)
+  {
+    int i, pos;
+    for (i = 0; i < (FLOW_KEY_SZ * 8 + 31) / 32; i++)
+        v[i] = 0;
+    for (i = 0; i < FLOW_KEY_SZ; i++)
+    {
+        pos = (FLOW_KEY_SZ - 1 - i) * 8;
+        v[pos / 32] |= ((svBitVecVal) key[i]) << (pos % 32);
+    }
+  }
+
+/*! \brief Extract outer/inner flow keys and 64 bit hash of a pkt
+ *
+ * Usage: hash = pv_flow_key (pkt, len, vxlan_prt, lisp_prt, otv_prt, stt_prt, outer, inner)
+ *
+ * Walks eth, dot1q/alt1q/stag, mpls, ipv4, ipv6 (+ ext hdrs), gre, udp,
+ * tcp, vxlan, lisp, otv and stt with pktlib default etypes/protocols and
+ * the given udp/tcp tunnel dst ports over first len bytes of pkt (pkt
+ * without crc/pad). outer is the first
+ * ip hdr, inner the last one after a tunnel (all 0 if there is none). The
+ * hash is FNV-1a 64 of {outer, inner}, same as pktlib_main_class::flow_hash.
+ */
+  long long pv_flow_key (const svOpenArrayHandle pkt,
+                         int                     len,
+                         int                     vxlan_prt,
+                         int                     lisp_prt,
+                         int                     otv_prt,
+                         int                     stt_prt,
+                         svBitVecVal            *outer,
+                         svBitVecVal            *inner)
+  {
+    const svBitVec32 *p;
+    uint8_t           key [2][FLOW_KEY_SZ];
+    uint8_t          *cur = NULL;
+    uint64_t          hash;
+    int               off = 0, nxt = F_ETH, n_ip = 0, i, n, lbl, lbl0, nib, hlen, prt;
+
+    p = (const svBitVec32*) svGetArrayPtr(pkt);
+    memset (key, 0, sizeof (key));
+#define B(x)  ((int) (p[(x)] & 0xff))
+#define B2(x) ((B(x) << 8) | B((x) + 1))
+    while (nxt != F_DONE)
+    {
+        hlen = 0;
+        switch (nxt)
+        {
+            case F_ETH :
+                hlen = 14;
+                if (off + hlen > len) return 0;
+                nxt  = flow_from_etype (B2(off + 12));
+                break;
+            case F_VLAN :
+                hlen = 4;
+                if (off + hlen > len) { nxt = F_DONE; break; }
+                nxt  = flow_from_etype (B2(off + 2));
+                break;
+            case F_MPLS :
+                lbl0 = lbl = -1;
+                for (n = 0; n < FLOW_MAX_MPLS; n++)
+                {
+                    if (off + (n * 4) + 4 > len) break;
+                    lbl = (B2(off + n * 4) << 4) | (B(off + n * 4 + 2) >> 4);
+                    if (n == 0) lbl0 = lbl;
+                    if (B(off + n * 4 + 2) & 1) { n++; break; }
+                }
+                hlen = n * 4;
+                nib  = (off + hlen < len) ? B(off + hlen) : 0xAA;
+                if ((lbl0 != 3) && ((nib >> 5) == 0))
+                    hlen += 4;  /* eth ctrl word */
+                nxt  = F_DONE;
+                if (off + hlen < len)
+                {
+                    if (lbl == 0) nxt = F_IPV4;
+                    if (lbl == 2) nxt = F_IPV6;
+                    if (lbl0 == 3) nxt = F_ETH;
+                    if ((lbl0 != 3) && ((nib >> 5) == 0)) nxt = F_ETH;
+                    if ((lbl != 0) && ((nib >> 4) == 4))  nxt = F_IPV4;
+                    if ((lbl != 2) && ((nib >> 4) == 6))  nxt = F_IPV6;
+                }
+                break;
+            case F_IPV4 :
+                if (off + 20 > len) { nxt = F_DONE; break; }
+                hlen = (B(off) & 0xf) * 4;
+                cur  = key[n_ip++ ? 1 : 0];
+                memset (cur, 0, FLOW_KEY_SZ);
+                cur[0] = 4;
+                for (i = 0; i < 4; i++)
+                {
+                    cur[13 + i] = B(off + 12 + i);
+                    cur[29 + i] = B(off + 16 + i);
+                }
+                cur[33] = B(off + 9);
+                /* non first fragment carries no l4 hdr */
+                if ((hlen < 20) || (((B(off + 6) & 0x1f) << 8) | B(off + 7)))
+                    nxt = F_DONE;
+                else
+                    nxt = flow_from_prot (cur[33]);
+                break;
+            case F_IPV6 :
+                hlen = 40;
+                if (off + hlen > len) { nxt = F_DONE; break; }
+                cur  = key[n_ip++ ? 1 : 0];
+                memset (cur, 0, FLOW_KEY_SZ);
+                cur[0] = 6;
+                for (i = 0; i < 16; i++)
+                {
+                    cur[1 + i]  = B(off + 8 + i);
+                    cur[17 + i] = B(off + 24 + i);
+                }
+                cur[33] = B(off + 6);
+                nxt     = flow_from_prot (cur[33]);
+                break;
+            case F_IPV6_EXT :
+                if (off + 2 > len) { nxt = F_DONE; break; }
+                hlen = (B(off + 1) + 1) * 8;
+                if (cur) cur[33] = B(off);
+                nxt  = flow_from_prot (B(off));
+                break;
+            case F_GRE :
+                if (off + 4 > len) { nxt = F_DONE; break; }
+                hlen = 4 + (((B(off) >> 6) & 3) ? 4 : 0) + (((B(off) >> 5) & 1) * 4) +
+                           (((B(off) >> 4) & 1) * 4)     + (((B(off + 1) >> 7) & 1) * 4);
+                nxt  = flow_from_etype (B2(off + 2));
+                break;
+            case F_UDP :
+            case F_TCP :
+                hlen = (nxt == F_UDP) ? 8 : 20;
+                if (off + hlen > len) { nxt = F_DONE; break; }
+                if (cur)
+                {
+                    cur[34] = B(off);     cur[35] = B(off + 1);
+                    cur[36] = B(off + 2); cur[37] = B(off + 3);
+                }
+                prt = B2(off + 2);
+                if (nxt == F_UDP)
+                {
+                    /* same order as get_hid_from_udp_dst_prt */
+                    if      (prt == lisp_prt)  nxt = F_LISP;
+                    else if (prt == otv_prt)   nxt = F_OTV;
+                    else if (prt == vxlan_prt) nxt = F_VXLAN;
+                    else                       nxt = F_DONE;
+                }
+                else
+                {
+                    hlen = (B(off + 12) >> 4) * 4;
+                    nxt  = ((hlen >= 20) && (prt == stt_prt)) ? F_STT : F_DONE;
+                }
+                break;
+            case F_VXLAN :
+            case F_OTV :
+                hlen = 8;
+                nxt  = F_ETH;
+                break;
+            case F_LISP :
+                hlen = 8;
+                nib  = (off + hlen < len) ? (B(off + hlen) >> 4) : 0;
+                nxt  = (nib == 4) ? F_IPV4 : (nib == 6) ? F_IPV6 : F_DONE;
+                break;
+            case F_STT :
+                hlen = 18;
+                nxt  = F_ETH;
+                break;
+            default :
+                nxt  = F_DONE;
+                break;
+        }
+        off += hlen;
+        if ((hlen <= 0) || (off >= len))
+            nxt = F_DONE;
+    }
+#undef B
+#undef B2
+    /* FNV-1a 64 over {outer, inner} */
+    hash = 0xcbf29ce484222325ULL;
+    for (i = 0; i < 2 * FLOW_KEY_SZ; i++)
+    {
+        hash ^= key[i / FLOW_KEY_SZ][i % FLOW_KEY_SZ];
+        hash *= 0x100000001b3ULL;
+    }
+    flow_key_to_sv (key[0], outer);
+    flow_key_to_sv (key[1], inner);
+    return (long long) hash;
+  }
+
+#if defined(__cplusplus)
+}
+#endif
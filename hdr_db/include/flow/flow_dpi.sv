@@ -0,0 +1,27 @@
+/*! \file flow_dpi.sv
+ * Contains the DPI-C routine used to extract flow keys of a pkt without
+ * unpack (see flow_dpi.c). Included by pktlib_include.svh when
+ * PKTLIB_DPI_FLOW is defined.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+  //  Extract outer/inner flow keys and 64 bit hash of a pkt
+  import "DPI-C" function longint pv_flow_key (
+               input  bit [7:0]   pkt[],     // pkt bytes
+               input  int         len,       // bytes to walk (pkt without crc/pad)
+               input  int         vxlan_prt, // udp dst_prt of vxlan
+               input  int         lisp_prt,  // udp dst_prt of lisp
+               input  int         otv_prt,   // udp dst_prt of otv
+               input  int         stt_prt,   // tcp dst_prt of stt
+               output bit [303:0] outer,     // pktlib_flow_key_t of first ip hdr
+               output bit [303:0] inner);    // pktlib_flow_key_t of last ip hdr after a tunnel
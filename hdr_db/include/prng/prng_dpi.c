@@ -0,0 +1,99 @@
+/*! \file prng_dpi.c
+ * Contains the DPI-C routines used to fill payload arrays with random data.
+ * Uses xoshiro256** seeded through splitmix64, one call fills the whole
+ * array with 8 bytes per PRNG step.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdint.h>
+#include <svdpi.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+  static inline uint64_t prng_rotl (const uint64_t x, int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static uint64_t prng_splitmix64 (uint64_t *x)
+  {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  static inline uint64_t prng_next (uint64_t *s)
+  {
+    const uint64_t result = prng_rotl (s[1] * 5, 7) * 9;
+    const uint64_t t      = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3]  = prng_rotl (s[3], 45);
+    return result;
+  }
+
+/*! \brief Seed the PRNG
+ *
+ * Usage: pv_prng_seed (st, seed)
+ *
+ * Seeds PRNG state st (4 words, owned by the caller). Same seed gives same
+ * sequence of payload bytes.
+ */
+  void pv_prng_seed (svOpenArrayHandle st,
+                     long long         seed)
+  {
+    uint64_t *s = (uint64_t*) svGetArrayPtr(st);
+    uint64_t  x = (uint64_t) seed;
+    int       i;
+    for (i = 0; i < 4; i++)
+        s[i] = prng_splitmix64 (&x);
+  }
+
+/*! \brief Fill an array with random bytes
+ *
+ * Usage: pv_prng_fill (st, data, len)
+ *
+ * Fills first len bytes of open array data, 8 bytes per step of PRNG
+ * state st.
+ */
+  void pv_prng_fill (svOpenArrayHandle st,
+                     svOpenArrayHandle data,
+                     int               len)
+  {
+    svBitVec32 *data_ptr;
+    uint64_t   *s;
+    uint64_t    r;
+    int         i, j;
+    s        = (uint64_t*) svGetArrayPtr(st);
+    data_ptr = (svBitVec32*) svGetArrayPtr(data);
+    for (i = 0; i < len; i += 8)
+    {
+        r = prng_next (s);
+        for (j = 0; (j < 8) && ((i + j) < len); j++)
+        {
+            data_ptr[i + j] = (svBitVec32) (r & 0xff);
+            r >>= 8;
+        }
+    }
+  }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,27 @@
+/*! \file prng_dpi.sv
+ * Contains the DPI-C routines used to fill payload arrays with random data
+ * (see prng_dpi.c). Included by pktlib_include.svh when PKTLIB_DPI_PRNG is
+ * defined.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+  //  Seed the payload PRNG
+  import "DPI-C" function void pv_prng_seed (
+               inout  longint unsigned st[], // PRNG state of caller, 4 words
+               input  longint     seed);     // same seed gives same payload
+
+  //  Fill an array with random bytes
+  import "DPI-C" function void pv_prng_fill (
+               inout  longint unsigned st[], // PRNG state of caller, 4 words
+               inout  bit [7:0]   data[],    // array to fill
+               input  int         len);      // number of bytes to fill
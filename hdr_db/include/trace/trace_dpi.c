@@ -0,0 +1,332 @@
+/*! \file trace_dpi.c
+ * Contains the DPI-C routines used to write/read the binary pkt trace of
+ * pktlib (pkt bytes plus hdr_sig, pid, pnum, path, drv_ctrl, sim time and
+ * status per record). Built with -DPKTLIB_TRACE_CLI it is also the native
+ * decoder, printing records in pktlib hexdump format.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#ifndef PKTLIB_TRACE_CLI
+#include <svdpi.h>
+#endif
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* file  : "PKTLTRC1", then records
+ * record: len, status, hdr_sig[8], time[8], pid, pnum, path, drv_ctrl,
+ *         pkt_format, rsvd (all little endian, 4 bytes unless noted),
+ *         followed by len pkt bytes */
+#define TRACE_MAGIC     "PKTLTRC1"
+#define TRACE_REC_HDR   48
+#define TRACE_MAX_OPEN  16
+#define TRACE_BUFSIZE   (1 << 20)
+
+  typedef struct
+  {
+    uint32_t len;
+    uint32_t status;
+    uint64_t hdr_sig;
+    uint64_t time;
+    uint32_t pid;
+    uint32_t pnum;
+    uint32_t path;
+    uint32_t drv_ctrl;
+    uint32_t pkt_format;
+  } trace_rec_t;
+
+  typedef struct
+  {
+    FILE    *fp;
+    uint8_t *pkt;     /* bytes of last record read */
+    uint32_t pkt_sz;
+  } trace_handle_t;
+
+  static trace_handle_t trace_handle[TRACE_MAX_OPEN];
+
+  static uint32_t get_u32 (const uint8_t *b)
+  {
+    return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t) b[3] << 24);
+  }
+
+  static uint64_t get_u64 (const uint8_t *b)
+  {
+    return get_u32 (b) | ((uint64_t) get_u32 (b + 4) << 32);
+  }
+
+/*! \brief Open a trace file, rd 0 -> writing, 1 -> reading
+ *
+ * Returns handle to be passed to other pv_trace_* calls, -1 on error
+ */
+  int pv_trace_open (const char *fname, int rd)
+  {
+    int  h;
+    char magic[8];
+    for (h = 0; h < TRACE_MAX_OPEN; h++)
+    {
+        if (trace_handle[h].fp == NULL)
+            break;
+    }
+    if (h == TRACE_MAX_OPEN)
+        return -1;
+    trace_handle[h].fp = fopen (fname, rd ? "rb" : "wb");
+    if (trace_handle[h].fp == NULL)
+        return -1;
+    if (rd)
+    {
+        if ((fread (magic, 1, 8, trace_handle[h].fp) != 8) || memcmp (magic, TRACE_MAGIC, 8))
+        {
+            fclose (trace_handle[h].fp);
+            trace_handle[h].fp = NULL;
+            return -1;
+        }
+    }
+    else
+    {
+        setvbuf (trace_handle[h].fp, NULL, _IOFBF, TRACE_BUFSIZE);
+        fwrite (TRACE_MAGIC, 1, 8, trace_handle[h].fp);
+    }
+    return h;
+  }
+
+  /* reads next record, its bytes are kept in handle. Returns -1 at end */
+  static int trace_read_rec (int h, trace_rec_t *r)
+  {
+    uint8_t b[TRACE_REC_HDR];
+    if ((h < 0) || (h >= TRACE_MAX_OPEN) || (trace_handle[h].fp == NULL))
+        return -1;
+    if (fread (b, 1, TRACE_REC_HDR, trace_handle[h].fp) != TRACE_REC_HDR)
+        return -1;
+    r->len        = get_u32 (b +  0);
+    r->status     = get_u32 (b +  4);
+    r->hdr_sig    = get_u64 (b +  8);
+    r->time       = get_u64 (b + 16);
+    r->pid        = get_u32 (b + 24);
+    r->pnum       = get_u32 (b + 28);
+    r->path       = get_u32 (b + 32);
+    r->drv_ctrl   = get_u32 (b + 36);
+    r->pkt_format = get_u32 (b + 40);
+    if (r->len > trace_handle[h].pkt_sz)
+    {
+        free (trace_handle[h].pkt);
+        trace_handle[h].pkt    = (uint8_t *) malloc (r->len);
+        trace_handle[h].pkt_sz = r->len;
+    }
+    if (fread (trace_handle[h].pkt, 1, r->len, trace_handle[h].fp) != r->len)
+        return -1;
+    return 0;
+  }
+
+/*! \brief Close a trace file, flushes pending records
+ */
+  void pv_trace_close (int h)
+  {
+    if ((h < 0) || (h >= TRACE_MAX_OPEN) || (trace_handle[h].fp == NULL))
+        return;
+    fclose (trace_handle[h].fp);
+    free (trace_handle[h].pkt);
+    trace_handle[h].fp     = NULL;
+    trace_handle[h].pkt    = NULL;
+    trace_handle[h].pkt_sz = 0;
+  }
+
+#ifndef PKTLIB_TRACE_CLI
+  static void put_u32 (uint8_t *b, uint32_t v)
+  {
+    b[0] = v; b[1] = v >> 8; b[2] = v >> 16; b[3] = v >> 24;
+  }
+
+  static void put_u64 (uint8_t *b, uint64_t v)
+  {
+    put_u32 (b, (uint32_t) v);
+    put_u32 (b + 4, (uint32_t) (v >> 32));
+  }
+
+  static int trace_write_rec (int h, const trace_rec_t *r, const uint8_t *pkt)
+  {
+    uint8_t b[TRACE_REC_HDR];
+    if ((h < 0) || (h >= TRACE_MAX_OPEN) || (trace_handle[h].fp == NULL))
+        return -1;
+    memset (b, 0, TRACE_REC_HDR);
+    put_u32 (b +  0, r->len);
+    put_u32 (b +  4, r->status);
+    put_u64 (b +  8, r->hdr_sig);
+    put_u64 (b + 16, r->time);
+    put_u32 (b + 24, r->pid);
+    put_u32 (b + 28, r->pnum);
+    put_u32 (b + 32, r->path);
+    put_u32 (b + 36, r->drv_ctrl);
+    put_u32 (b + 40, r->pkt_format);
+    fwrite (b, 1, TRACE_REC_HDR, trace_handle[h].fp);
+    fwrite (pkt, 1, r->len, trace_handle[h].fp);
+    return 0;
+  }
+
+/*! \brief Append one pkt record, bytes are copied in to stdio buffer only
+ */
+  void pv_trace_write (int               h,
+                       svOpenArrayHandle pkt,
+                       int               len,
+                       long long         hdr_sig,
+                       long long         time,
+                       int               pid,
+                       int               pnum,
+                       int               path,
+                       int               drv_ctrl,
+                       int               pkt_format,
+                       int               status)
+  {
+    svBitVec32  *pkt_ptr;
+    static uint8_t *buf    = NULL;
+    static int      buf_sz = 0;
+    trace_rec_t  r;
+    int          i;
+    pkt_ptr = (svBitVec32*) svGetArrayPtr (pkt);
+    if (len > buf_sz)
+    {
+        free (buf);
+        buf    = (uint8_t *) malloc (len);
+        buf_sz = len;
+    }
+    for (i = 0; i < len; i++)
+        buf[i] = (uint8_t) pkt_ptr[i];
+    r.len        = len;
+    r.status     = status;
+    r.hdr_sig    = (uint64_t) hdr_sig;
+    r.time       = (uint64_t) time;
+    r.pid        = pid;
+    r.pnum       = pnum;
+    r.path       = path;
+    r.drv_ctrl   = drv_ctrl;
+    r.pkt_format = pkt_format;
+    trace_write_rec (h, &r, buf);
+  }
+
+/*! \brief Read next record, returns its pkt length or -1 at end of trace.
+ *  Pkt bytes are fetched with pv_trace_get_pkt in to an array of that size
+ */
+  int pv_trace_read (int        h,
+                     long long *hdr_sig,
+                     long long *time,
+                     int       *pid,
+                     int       *pnum,
+                     int       *path,
+                     int       *drv_ctrl,
+                     int       *pkt_format,
+                     int       *status)
+  {
+    trace_rec_t r;
+    if (trace_read_rec (h, &r) < 0)
+        return -1;
+    *hdr_sig    = (long long) r.hdr_sig;
+    *time       = (long long) r.time;
+    *pid        = r.pid;
+    *pnum       = r.pnum;
+    *path       = r.path;
+    *drv_ctrl   = r.drv_ctrl;
+    *pkt_format = r.pkt_format;
+    *status     = r.status;
+    return r.len;
+  }
+
+  void pv_trace_get_pkt (int               h,
+                         svOpenArrayHandle pkt)
+  {
+    svBitVec32 *pkt_ptr;
+    int         i, len;
+    pkt_ptr = (svBitVec32*) svGetArrayPtr (pkt);
+    len     = svSize (pkt, 1);
+    for (i = 0; (i < len) && (i < (int) trace_handle[h].pkt_sz); i++)
+        pkt_ptr[i] = trace_handle[h].pkt[i];
+  }
+#else
+/* ----------------------------------------------------------------------
+ *  native decoder
+ *  Usage : pktlib_trace_decode <trace> [first [last]] [-pid <pid>]
+ *  Records are numbered from 1. Full hdr field display needs the hdr
+ *  classes, use test/pktlib_trace_decode.sv for it.
+ * ---------------------------------------------------------------------- */
+  static const char *status_name[] = {"PACK", "UNPACK", "CMP_PASS", "CMP_FAIL"};
+
+  /* same layout as pktlib_display_class::display_array8 */
+  static void display_array8 (const uint8_t *data, uint32_t len)
+  {
+    const char *hname = "         pkt_lib";
+    uint32_t    i;
+    printf ("%s :        0  1  2  3  4  5  6  7 |  8  9 10 11 12 13 14 15\n", hname);
+    printf ("%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~\n", hname);
+    for (i = 0; i < len; i++)
+    {
+        if (i % 16 == 0)
+            printf ("%s : %4u : ", hname, i);
+        printf ("%02x ", data[i]);
+        if (i % 16 == 7)
+            printf ("| ");
+        if ((i % 16 == 15) || (i == len - 1))
+            printf ("\n");
+    }
+    printf ("%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~\n", hname);
+    printf ("%s : (Total Len  = %u)\n\n", hname, len);
+  }
+
+  int main (int argc, char **argv)
+  {
+    trace_rec_t r;
+    long        first = 1, last = -1, pid = -1, n = 0;
+    int         h, i, pos = 0;
+    if (argc < 2)
+    {
+        fprintf (stderr, "Usage : %s <trace> [first [last]] [-pid <pid>]\n", argv[0]);
+        return 1;
+    }
+    for (i = 2; i < argc; i++)
+    {
+        if (!strcmp (argv[i], "-pid") && (i + 1 < argc))
+            pid = strtol (argv[++i], NULL, 0);
+        else if (pos++ == 0)
+            first = strtol (argv[i], NULL, 0);
+        else
+            last  = strtol (argv[i], NULL, 0);
+    }
+    h = pv_trace_open (argv[1], 1);
+    if (h < 0)
+    {
+        fprintf (stderr, "%s : can't open trace %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    while (trace_read_rec (h, &r) == 0)
+    {
+        n++;
+        if ((n < first) || ((last != -1) && (n > last)))
+            continue;
+        if ((pid != -1) && (r.pid != (uint32_t) pid))
+            continue;
+        printf ("%llu : INFO    : TRACE     : Pkt %ld %s pid %u pnum %u path %u drv_ctrl %u pkt_format %u hdr_sig %016llx\n",
+                (unsigned long long) r.time, n, (r.status < 4) ? status_name[r.status] : "?",
+                r.pid, r.pnum, r.path, r.drv_ctrl, r.pkt_format, (unsigned long long) r.hdr_sig);
+        display_array8 (trace_handle[h].pkt, r.len);
+    }
+    pv_trace_close (h);
+    return 0;
+  }
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
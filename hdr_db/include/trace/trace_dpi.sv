@@ -0,0 +1,56 @@
+/*! \file trace_dpi.sv
+ * Contains the DPI-C routines used to write/read the binary pkt trace
+ * (see trace_dpi.c). Included by pktlib_include.svh when
+ * PKTLIB_DPI_TRACE is defined.
+ */
+/* Copyright (c) 2011, Sachin Gandhi
+   All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+  //  Open trace file, returns handle or -1
+  import "DPI-C" function int pv_trace_open (
+               input  string      fname,      // trace file name
+               input  int         rd = 0);    // 0 -> writing, 1 -> reading
+
+  //  Close trace file
+  import "DPI-C" function void pv_trace_close (
+               input  int         h);         // handle from pv_trace_open
+
+  //  Append one pkt record
+  import "DPI-C" function void pv_trace_write (
+               input  int         h,          // handle from pv_trace_open
+               input  bit [7:0]   pkt[],      // pkt bytes
+               input  int         len,        // pkt length
+               input  longint     hdr_sig,    // hdr stack signature
+               input  longint     sim_time,   // simulation time
+               input  int         pid,
+               input  int         pnum,
+               input  int         path,
+               input  int         drv_ctrl,
+               input  int         pkt_format,
+               input  int         status);    // trace_status
+
+  //  Read next record, returns pkt length or -1 at end of trace
+  import "DPI-C" function int pv_trace_read (
+               input  int         h,
+               output longint     hdr_sig,
+               output longint     sim_time,
+               output int         pid,
+               output int         pnum,
+               output int         path,
+               output int         drv_ctrl,
+               output int         pkt_format,
+               output int         status);
+
+  //  Get pkt bytes of record read last, pkt is sized to its length by caller
+  import "DPI-C" function void pv_trace_get_pkt (
+               input  int         h,
+               output bit [7:0]   pkt[]);
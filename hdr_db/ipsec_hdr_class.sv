@@ -60,6 +60,9 @@ class ipsec_hdr_class extends hdr_class; // {
   rand bit [7:0]   rsvd;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [127:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
   local int i;
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
@@ -145,16 +148,16 @@ class ipsec_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int pkt_ptr;
 
     // pack class members
     pkt_ptr = index;
     `ifdef SVFNYI_0
     pack_vec = {spi, seq_num, iv};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{spi, seq_num, iv}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({spi, seq_num, iv});
     `endif
 
     // pack next hdr
@@ -168,11 +171,11 @@ class ipsec_hdr_class extends hdr_class; // {
 
     // pack trailer
     `ifdef SVFNYI_0
-    pack_vec = {{pad_len*8{1'b0}}, pad_len, protocol};
-    harray.pack_bit (pkt, pack_vec, index, (pad_len+2)*8);
+    index += pad_len*8; // pad is all 0s
+    pktlib_vec_class #(16)::pack_bit (pkt, {pad_len, protocol}, index);
     `else
-    hdr = {>>{pad, pad_len, protocol}};
-    harray.pack_array_8 (hdr, pkt, index);
+    harray.pack_array_8 (pad, pkt, index);
+    `PACK_FLDS({pad_len, protocol});
     `endif
 
     // post_pack task to encrypt and add ICV to packet
@@ -185,6 +188,7 @@ class ipsec_hdr_class extends hdr_class; // {
         index += icv_sz;
         `endif
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -192,6 +196,7 @@ class ipsec_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     int       pkt_ptr;
     // unpack class members
@@ -199,11 +204,10 @@ class ipsec_hdr_class extends hdr_class; // {
     sectag_sz     = 16;
     update_len (index, pkt.size, 16);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, sectag_sz);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, sectag_sz);
     {spi, seq_num, iv} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, sectag_sz);
-    {>>{spi, seq_num, iv}} = hdr;
+    `UNPACK_FLDS({spi, seq_num, iv}, sectag_sz);
     `endif
 
     // decrypt pkt and remove icv from packet - trl_len is 0 as icv and trailer is removed
@@ -237,14 +241,13 @@ class ipsec_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref   bit [7:0] pkt [],
                   input int       index,
                   input int       enc_dcr = 1); // {
+    `PROF_BEGIN
     bit [7:0]     out_pkt [];
     bit [31:0]    iv1;
     bit [31:0]    iv2;
@@ -271,7 +274,7 @@ class ipsec_hdr_class extends hdr_class; // {
     begin // {
         avl_len = pkt.size - icv_sz;
         lcl_toh = new (super.plib);
-        $cast (lcl_toh, super.all_hdr[i]);
+        $cast (lcl_toh, super.hdr_stk.all_hdr[i]);
         if (lcl_toh.cal_n_add_crc)
             avl_len = pkt.size - icv_sz - 4;
         else
@@ -290,26 +293,36 @@ class ipsec_hdr_class extends hdr_class; // {
     auth_only   = !enc_en;
 
     // dpi call to enc/dec and authenticate pkt
+    // gcm_crypt only reads pkt[0 +: avl_len], so pkt is not truncated on encrypt
     `ifndef NO_PROCESS_AE
-    pkt     = new [avl_len] (pkt); 
+    if (enc_dcr != 1)
+        pkt = new [avl_len] (pkt); 
     out_pkt = new [avl_len + icv_sz];
     iv1     = {iv_offset, iv[63:32]};
     iv2     = iv[31:0];
-    gcm_crypt (key,
-               iv1,
-               iv2,
-               auth_only,
-               auth_st,
-               auth_sz,
-               enc_dcr,
-               enc_sz,
-               pkt,
-               out_pkt,
-               out_plen);
+    begin // {
+        `PROF_BEGIN
+        gcm_crypt (key,
+                   iv1,
+                   iv2,
+                   auth_only,
+                   auth_st,
+                   auth_sz,
+                   enc_dcr,
+                   enc_sz,
+                   pkt,
+                   out_pkt,
+                   out_plen);
+        `PROF_DPI ("gcm_crypt", hdr_name)
+    end // }
     `endif
     index = out_pkt.size - 16;
     if (enc_dcr == 1)
-        pkt = new[super.plib.org_pkt.size] (out_pkt);
+    begin // {
+        // pkt is already of final size, copy enc data + ICV in place
+        foreach (out_pkt[ls])
+            pkt[ls] = out_pkt[ls];
+    end // }
     else
     begin // {
         // Removing ICV from the packet 
@@ -322,6 +335,7 @@ class ipsec_hdr_class extends hdr_class; // {
     end // }
     harray.copy_array (out_pkt, icv, index, 16);
     out_pkt.delete();
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
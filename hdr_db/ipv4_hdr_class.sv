@@ -100,10 +100,9 @@ class ipv4_hdr_class extends hdr_class; // {
   rand bit [7:0]     options[];
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-  local bit [7:0]    chksm_data [];
-  local int          chksm_idx;
-  local bit [7:0]    pseudo_chksm_data [];
-  local int          pseudo_chksm_idx;
+  `ifdef SVFNYI_0
+         bit [159:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
         bit [15:0]   pseudo_chksm;
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
@@ -225,34 +224,77 @@ class ipv4_hdr_class extends hdr_class; // {
     end // }
   endfunction : post_randomize // }
 
+  function bit fast_randomize (); // {
+    // total_length can't be corrupted on top of itself without solver
+    if (~cal_total_length & corrupt_total_length)
+        return 1'b0;
+    version = 4'h4;
+    if (corrupt_ip_version)
+    begin // {
+        while (version == 4'h4)
+            version = $urandom;
+    end // }
+    if (corrupt_ihl)
+        ihl = $urandom_range (4, 0);
+    else
+        ihl = $urandom_range (15, 5);
+    hdr_len = (ihl > 4'h4) ? ihl*4 : 20;
+    trl_len = 0;
+    {tos, id, ttl} = $urandom;
+    ip_sa    = $urandom;
+    ip_da    = $urandom;
+    reserved = null_rsvd ? 1'b0 : $urandom;
+    if (corrupt_mf_df)
+        {df, mf} = 2'b11;
+    else
+        {df, mf} = $urandom_range (2, 0);
+    if (corrupt_frag_offset)
+    begin // {
+        df          = 1'b1;
+        mf          = corrupt_mf_df;
+        frag_offset = $urandom_range (8191, 1);
+    end // }
+    else
+        frag_offset = df ? 0 : $urandom;
+    if (~cal_total_length)
+        total_length = $urandom;
+    protocol = get_fast_prot (nxt_hdr.hid);
+    checksum = 16'h0;
+    options  = new [(ihl > 4'h5) ? (ihl-5)*4 : 0];
+    if (harray.data_pattern == "RND")
+        harray.fill_array (options);
+    post_randomize ();
+    return 1'b1;
+  endfunction : fast_randomize // }
+
+  function void fast_post_len (); // {
+    if (cal_total_length)
+        total_length = corrupt_total_length ? (total_hdr_len + corrupt_total_len_by) : total_hdr_len;
+    if (~corrupt_frag_offset_range & (frag_offset >= (65536 - total_length)))
+        frag_offset = frag_offset % (65536 - total_length);
+  endfunction : fast_post_len // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
+    int ip_idx;
     `ifdef SVFNYI_0
     int tmp_idx;
     `endif
-    // Calulate ip_chksm, corrupt it if asked
-    if (~last_pack)
-    begin // {
-        if (cal_ip_chksm)
-        begin // {
-            chksm_data = new[ihl*4];
-            chksm_idx  = 0;
-            checksum   = 0;
-            pack_hdr (chksm_data, chksm_idx, 1'b1);
-            checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_ip_chksm, corrupt_ip_chksm_msk);
-        end // }
-        else
-        begin // {
-            if (corrupt_ip_chksm)
-                checksum ^= corrupt_ip_chksm_msk;
-        end // }
-    end // }
+    // making sure checksum is 0, incase pack_hdr was called before radomization
+    if (~last_pack & cal_ip_chksm)
+        checksum = 0;
+    `ifdef SVFNYI_0
+    ip_idx = index/8;
+    `else
+    ip_idx = index;
+    `endif
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {version, ihl, tos, total_length, id, reserved, df, mf,
                 frag_offset, ttl, protocol, checksum, ip_sa, ip_da};
-    harray.pack_bit (pkt, pack_vec, index, 160);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 160);
     if (ihl > 5)
     begin // {
         tmp_idx = index/8;
@@ -260,14 +302,21 @@ class ipv4_hdr_class extends hdr_class; // {
         index = tmp_idx * 8;
     end // }
     `else
+    `PACK_FLDS({version, ihl, tos, total_length, id, reserved, df, mf,
+               frag_offset, ttl, protocol, checksum, ip_sa, ip_da});
     if (ihl > 5)
-        hdr = {>>{version, ihl, tos, total_length, id, reserved, df, mf,
-                  frag_offset, ttl, protocol, checksum, ip_sa, ip_da, options}};
-    else
-        hdr = {>>{version, ihl, tos, total_length, id, reserved, df, mf,
-                  frag_offset, ttl, protocol, checksum, ip_sa, ip_da}};
-    harray.pack_array_8(hdr, pkt, index);
+        harray.pack_array_8 (options, pkt, index);
     `endif
+    // Calulate ip_chksm on pkt directly, corrupt it if asked
+    if (~last_pack)
+    begin // {
+        if (cal_ip_chksm)
+            checksum = crc_chksm.chksm16_slice(pkt, ip_idx, ihl*4, corrupt_ip_chksm, corrupt_ip_chksm_msk);
+        else if (corrupt_ip_chksm)
+            checksum ^= corrupt_ip_chksm_msk;
+        if (cal_ip_chksm | corrupt_ip_chksm)
+            {pkt[ip_idx+10], pkt[ip_idx+11]} = checksum;
+    end // }
     cal_pseudo_chksm ();
     // pack next hdr
     if (~last_pack)
@@ -277,24 +326,34 @@ class ipv4_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 20))
+        return -1;
+    nxt_hid = get_hid_from_protocol (pkt[index+9]);
+    return (pkt[index][3:0] * 4);
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 20);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, 20);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 20);
     {version, ihl, tos, total_length, id, reserved, df, mf,
      frag_offset, ttl, protocol, checksum, ip_sa, ip_da} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, 20);
-    {>>{version, ihl, tos, total_length, id, reserved, df, mf,
-        frag_offset, ttl, protocol, checksum, ip_sa, ip_da}} = hdr;
+    `UNPACK_FLDS({version, ihl, tos, total_length, id, reserved, df, mf,
+                 frag_offset, ttl, protocol, checksum, ip_sa, ip_da}, 20);
     `endif
     hdr_len = ihl * 4;
     if (ihl > 4'd5)
@@ -316,9 +375,7 @@ class ipv4_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -343,8 +400,6 @@ class ipv4_hdr_class extends hdr_class; // {
     this.ip_da                     = lcl.ip_da;
     this.options                   = lcl.options;            
     // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-    this.chksm_data                = lcl.chksm_data;
-    this.chksm_idx                 = lcl.chksm_idx;
     this.pseudo_chksm              = lcl.pseudo_chksm;
     // ~~~~~~~~~~ Control variables ~~~~~~~~~~
     this.corrupt_ip_version        = lcl.corrupt_ip_version;       
@@ -409,10 +464,6 @@ class ipv4_hdr_class extends hdr_class; // {
     if ((mode == DISPLAY_FULL) | (mode == COMPARE_FULL))
     begin // {
     display_common_hdr_flds (hdis, lcl, mode); 
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "chksm_data", 0, 0, chksm_data, lcl.chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "chksm_idx", chksm_idx, lcl.chksm_idx);
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "pseudo_chksm_data", 0, 0, pseudo_chksm_data, lcl.pseudo_chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "pseudo_chksm_idx", pseudo_chksm_idx, lcl.pseudo_chksm_idx);
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 016, "pseudo_chksm", pseudo_chksm, lcl.pseudo_chksm);
     end // }
     if (~last_display & (cmp_cls.nxt_hdr.hid == nxt_hdr.hid))
@@ -420,18 +471,12 @@ class ipv4_hdr_class extends hdr_class; // {
   endtask : display_hdr // }
 
   // calculate pseudo ipv4 header checksum. It may be required for UDP or TCP
+  // pseudo hdr is summed as integers, {ip_data_length, 8'h0, protocol, ip_sa, ip_da}
   task cal_pseudo_chksm; // {
     bit [15:0] ip_data_length;
-    ip_data_length    = total_length - (ihl*4);
-    pseudo_chksm_idx  = 0;
-    pseudo_chksm      = 0;
-    `ifdef SVFNYI_0
-    pseudo_chksm_data = new[12];
-    pack_vec          = {ip_data_length, {8'h0, protocol}, ip_sa, ip_da};
-    harray.pack_bit (pseudo_chksm_data, pack_vec, pseudo_chksm_idx, 96);
-    `else
-    pseudo_chksm_data = {>>{ip_data_length, 8'h0, protocol, ip_sa, ip_da}}; 
-    `endif
-    pseudo_chksm      = crc_chksm.chksm16(pseudo_chksm_data, pseudo_chksm_data.size(), 0, 0, corrupt_ip_chksm_msk);
+    ip_data_length = total_length - (ihl*4);
+    pseudo_chksm   = ~crc_chksm.chksm16_fold (ip_data_length + protocol +
+                                              ip_sa[31:16] + ip_sa[15:0] +
+                                              ip_da[31:16] + ip_da[15:0]);
   endtask : cal_pseudo_chksm // }
 endclass : ipv4_hdr_class // }
@@ -82,6 +82,9 @@ class ipv6_ext_hdr_class extends hdr_class; // {
   rand bit [31:0]         identification;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [15:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit                null_rsvd = 1'b0;
@@ -156,17 +159,18 @@ class ipv6_ext_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     int tmp_idx;
     pack_vec = {protocol, hdr_ext_len};
-    harray.pack_bit (pkt, pack_vec, index, 16);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 16);
     tmp_idx = index/8;
     harray.pack_array_8(options, pkt, tmp_idx);
     index = tmp_idx * 8;
     `else
-    hdr = {>>{protocol, hdr_ext_len, options}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({protocol, hdr_ext_len});
+    harray.pack_array_8 (options, pkt, index);
     `endif
     // pack next hdr
     if (~last_pack)
@@ -176,23 +180,34 @@ class ipv6_ext_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 2))
+        return -1;
+    nxt_hid = get_hid_from_protocol (pkt[index]);
+    return ((pkt[index+1] + 1) * 8);
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, (pkt[index+1]+ 1) *8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, 2);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 2);
     {protocol, hdr_ext_len} = pack_vec;
     harray.copy_array (pkt, options, index, (hdr_len - 2));
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{protocol, hdr_ext_len, options}} = hdr;
+    `UNPACK_FLDS({protocol, hdr_ext_len}, 2);
+    harray.copy_array (pkt, options, index, (hdr_len - 2));
     `endif
     {frag_offset, frag_rsvd, M, identification} = {options[0], options[1], options[2], options[3], options[4], options[5]};
     {routing_type, seg_left} = {options[0], options[1]};
@@ -213,9 +228,7 @@ class ipv6_ext_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -63,10 +63,9 @@ class ipv6_hdr_class extends hdr_class; // {
   rand bit [127:0]        ip6_da;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-  local bit [7:0]         chksm_data [];
-  local int               chksm_idx;
-  local bit [7:0]         pseudo_chksm_data [];
-  local int               pseudo_chksm_idx;
+  `ifdef SVFNYI_0
+         bit [319:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
         bit [15:0]        pseudo_chksm;
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
@@ -124,16 +123,43 @@ class ipv6_hdr_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  function bit fast_randomize (); // {
+    // payload_len can't be corrupted on top of itself without solver
+    if (~cal_payload_len & corrupt_payload_len)
+        return 1'b0;
+    version = 4'h6;
+    if (corrupt_ip6_version)
+    begin // {
+        while (version == 4'h6)
+            version = $urandom;
+    end // }
+    {tos, flow_label} = $urandom;
+    ttl      = $urandom;
+    ip6_sa   = {$urandom, $urandom, $urandom, $urandom};
+    ip6_da   = {$urandom, $urandom, $urandom, $urandom};
+    protocol = get_fast_prot (nxt_hdr.hid);
+    if (~cal_payload_len)
+        payload_len = $urandom;
+    hdr_len  = 40;
+    trl_len  = 0;
+    return 1'b1;
+  endfunction : fast_randomize // }
+
+  function void fast_post_len (); // {
+    if (cal_payload_len)
+        payload_len = corrupt_payload_len ? (nxt_hdr.total_hdr_len + corrupt_pyld_len_by) : nxt_hdr.total_hdr_len;
+  endfunction : fast_post_len // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da});
     `endif
     cal_pseudo_chksm ();
     // pack next hdr
@@ -144,22 +170,32 @@ class ipv6_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 40))
+        return -1;
+    nxt_hid = get_hid_from_protocol (pkt[index+6]);
+    return 40;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 40);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da}} = hdr;
+    `UNPACK_FLDS({version, tos, flow_label, payload_len, protocol, ttl, ip6_sa, ip6_da}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -178,9 +214,7 @@ class ipv6_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -198,8 +232,6 @@ class ipv6_hdr_class extends hdr_class; // {
     this.ip6_sa              = lcl.ip6_sa;
     this.ip6_da              = lcl.ip6_da;
     // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
-    this.chksm_data          = lcl.chksm_data;
-    this.chksm_idx           = lcl.chksm_idx;
     this.pseudo_chksm        = lcl.pseudo_chksm;
     // ~~~~~~~~~~ Control variables ~~~~~~~~~~
     this.corrupt_ip6_version = lcl.corrupt_ip6_version;
@@ -237,10 +269,6 @@ class ipv6_hdr_class extends hdr_class; // {
     if ((mode == DISPLAY_FULL) | (mode == COMPARE_FULL))
     begin // {
     display_common_hdr_flds (hdis, lcl, mode); 
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "chksm_data", 0, 0, chksm_data, lcl.chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "chksm_idx", chksm_idx, lcl.chksm_idx);
-    hdis.display_fld (mode, hdr_name, ARRAY_NH,   DEF, 000, "pseudo_chksm_data", 0, 0, pseudo_chksm_data, lcl.pseudo_chksm_data);
-    hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "pseudo_chksm_idx", pseudo_chksm_idx, lcl.pseudo_chksm_idx);
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 016, "pseudo_chksm", pseudo_chksm, lcl.pseudo_chksm);
     end // }
     if (~last_display & (cmp_cls.nxt_hdr.hid == nxt_hdr.hid))
@@ -249,16 +277,12 @@ class ipv6_hdr_class extends hdr_class; // {
 
   // calculate pseudo ipv6 header checksum. It may be required for UDP or TCP
   task cal_pseudo_chksm (); // {
-    pseudo_chksm_idx  = 0;
-    pseudo_chksm      = 0;
-    `ifdef SVFNYI_0
-    pseudo_chksm_data = new[40];
-    pack_vec          = {32'h0, {8'h0, protocol}, payload_len, ip6_sa, ip6_da};
-    harray.pack_bit(pseudo_chksm_data, pack_vec, pseudo_chksm_idx, 320);
-    `else
-    pseudo_chksm_data = {>>{32'h0, 8'h0, protocol, payload_len, ip6_sa, ip6_da}}; 
-    `endif
-    pseudo_chksm      = crc_chksm.chksm16(pseudo_chksm_data, pseudo_chksm_data.size(), 0, 0, 16'hFFFF);
+    bit [31:0] sum;
+    // pseudo hdr is summed as integers, {32'h0, 8'h0, protocol, payload_len, ip6_sa, ip6_da}
+    sum = protocol + payload_len;
+    for (int i = 0; i < 8; i++)
+        sum += ip6_sa[i*16 +: 16] + ip6_da[i*16 +: 16];
+    pseudo_chksm = ~crc_chksm.chksm16_fold (sum);
   endtask : cal_pseudo_chksm // }
 
 endclass : ipv6_hdr_class // }
@@ -54,6 +54,9 @@ class lisp_hdr_class extends hdr_class; // {
   rand bit [23:0]    instance_id;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           corrupt_N_V = 1'b0;
@@ -106,6 +109,7 @@ class lisp_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     bit [55:0] tmp_hdr;
     // pack class members
     if (~V)
@@ -118,10 +122,9 @@ class lisp_hdr_class extends hdr_class; // {
     tmp_hdr[31:0]  = lsb;
     `ifdef SVFNYI_0
     pack_vec = {N, L, E, V, I, flags, tmp_hdr};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{N, L, E, V, I, flags, tmp_hdr}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({N, L, E, V, I, flags, tmp_hdr});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -131,24 +134,34 @@ class lisp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    bit [7:0] nxt_ip;
+    nxt_ip  = (pkt.size > (index + 8)) ? pkt[index+8] : 8'h0;
+    nxt_hid = (nxt_ip[7:4] == 4'h4) ? IPV4_HID : (nxt_ip[7:4] == 4'h6) ? IPV6_HID : DATA_HID;
+    return 8;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class  lcl_class;
     bit [7:0]  nxt_ip;
     
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {N, L, E, V, I, flags, nonce, lsb} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{N, L, E, V, I, flags, nonce, lsb}} = hdr;
+    `UNPACK_FLDS({N, L, E, V, I, flags, nonce, lsb}, hdr_len);
     `endif
     if (~V)
         {src_map_ver, dst_map_ver} = nonce;
@@ -177,9 +190,7 @@ class lisp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
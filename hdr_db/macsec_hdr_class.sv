@@ -72,6 +72,9 @@ class macsec_hdr_class extends hdr_class; // {
   rand bit [7:0]   icv [];
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [111:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
   local int i;
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
@@ -188,18 +191,18 @@ class macsec_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int pkt_ptr;
 
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = (tci[3]) ? {tci, an, sl, pn, sci, etype} : {tci, an, sl, pn, etype};
-    harray.pack_bit (pkt, pack_vec, index, sectag_sz*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, sectag_sz*8);
     `else
     if (tci[3])
-        hdr = {>>{tci, an, sl, pn, sci, etype}};
+        `PACK_FLDS({tci, an, sl, pn, sci, etype});
     else
-        hdr = {>>{tci, an, sl, pn, etype}};
-    harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({tci, an, sl, pn, etype});
     `endif
 
     // pack next hdr
@@ -222,6 +225,7 @@ class macsec_hdr_class extends hdr_class; // {
         index += icv_sz;
         `endif
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -229,6 +233,7 @@ class macsec_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     int       pkt_ptr;
     // unpack class members
@@ -236,22 +241,20 @@ class macsec_hdr_class extends hdr_class; // {
     begin // {
         sectag_sz = 16;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 14);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 14);
         {tci, an, sl, pn, sci} = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, 14);
-        {>>{tci, an, sl, pn, sci}} = hdr;
+        `UNPACK_FLDS({tci, an, sl, pn, sci}, 14);
         `endif
     end // }
     else
     begin // {
         sectag_sz = 8;
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 6);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 6);
         {tci, an, sl, pn} = pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, 6);
-        {>>{tci, an, sl, pn}} = hdr;
+        `UNPACK_FLDS({tci, an, sl, pn}, 6);
         `endif
     end // }
     icv_sz  = 16;
@@ -264,11 +267,10 @@ class macsec_hdr_class extends hdr_class; // {
     end // }
     //unpack etype
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, 2);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 2);
     etype = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, 2);
-    {>>{etype}} = hdr;
+    `UNPACK_FLDS({etype}, 2);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -287,14 +289,13 @@ class macsec_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref   bit [7:0] pkt [],
                   input int       index,
                   input int       enc_dcr = 1); // {
+    `PROF_BEGIN
     bit [7:0]     out_pkt [];
     int           out_plen;
     int           avl_len;
@@ -318,7 +319,7 @@ class macsec_hdr_class extends hdr_class; // {
     else
     begin // {
         lcl_toh = new (super.plib);
-        $cast (lcl_toh, super.all_hdr[i]);
+        $cast (lcl_toh, super.hdr_stk.all_hdr[i]);
         if (lcl_toh.cal_n_add_crc)
             avl_len = pkt.size - icv_sz - 4;
         else
@@ -339,33 +340,42 @@ class macsec_hdr_class extends hdr_class; // {
     cal_final_sci;
 
     // dpi call to enc/dec and authenticate pkt
+    // gcm_crypt only reads pkt[0 +: avl_len], so pkt is not truncated on encrypt
     `ifndef NO_PROCESS_AE
-    pkt     = new [avl_len] (pkt); 
+    if (enc_dcr != 1)
+        pkt = new [avl_len] (pkt); 
     out_pkt = new [avl_len + icv_sz];
-    gcm_crypt (key,
-               final_sci,
-               pn,
-               auth_only,
-               auth_st,
-               auth_sz,
-               enc_dcr,
-               enc_sz,
-               pkt,
-               out_pkt,
-               out_plen);
+    begin // {
+        `PROF_BEGIN
+        gcm_crypt (key,
+                   final_sci,
+                   pn,
+                   auth_only,
+                   auth_st,
+                   auth_sz,
+                   enc_dcr,
+                   enc_sz,
+                   pkt,
+                   out_pkt,
+                   out_plen);
+        `PROF_DPI ("gcm_crypt", hdr_name)
+    end // }
     `endif
     index = out_pkt.size - 16;
     if (enc_dcr == 1)
     begin // {
         if (corrupt_icv)
             harray.pack_array_8 (icv, out_pkt, index, 1'b1);
-        pkt = new[super.plib.org_pkt.size] (out_pkt);
+        // pkt is already of final size, copy enc data + ICV in place
+        foreach (out_pkt[ls])
+            pkt[ls] = out_pkt[ls];
     end // }
     else
         // Removing ICV from the packet 
         pkt = new[index] (out_pkt);
     harray.copy_array (out_pkt, icv, index, 16);
     out_pkt.delete();
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cal_final_sci; // {
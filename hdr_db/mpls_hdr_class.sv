@@ -42,6 +42,9 @@ class mpls_hdr_class extends hdr_class; // {
   rand bit [31:0] eth_ctrl;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [31:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
   rand int        num_mpls_lbl;
@@ -133,26 +136,25 @@ class mpls_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int i;
     // pack class members
     for (i = 0; i < num_mpls_lbl; i++)
     begin // {
         `ifdef SVFNYI_0
         pack_vec = {label[i], exp[i], s[i], ttl[i]};
-        harray.pack_bit (pkt, pack_vec, index, 32);
+        pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
         `else
-        hdr = {>>{label[i], exp[i], s[i], ttl[i]}};
-        harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({label[i], exp[i], s[i], ttl[i]});
         `endif
     end // }
     if ((nxt_hdr.hid == ETH_HID) & (label[0] !== eth_null_lbl))
     begin // {
         `ifdef SVFNYI_0
         pack_vec = eth_ctrl;
-        harray.pack_bit (pkt, pack_vec, index, 32);
+        pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 32);
         `else
-        hdr = {>>{eth_ctrl}};
-        harray.pack_array_8 (hdr, pkt, index);
+        `PACK_FLDS({eth_ctrl});
         `endif
     end // }
     // pack next hdr
@@ -163,13 +165,56 @@ class mpls_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    bit [19:0] lbl0, lbl;
+    bit [7:0]  nxtB;
+    int        n_lbl = 0;
+    bit        s_bit = 1'b0;
+    // walk label stack till bottom of stack
+    while (~s_bit)
+    begin // {
+        if ((pkt.size < (index + (n_lbl * 4) + 4)) | (n_lbl == `MAX_MPLS_LBL))
+            return -1;
+        lbl   = {pkt[index+(n_lbl*4)], pkt[index+(n_lbl*4)+1], pkt[index+(n_lbl*4)+2][7:4]};
+        s_bit = pkt[index+(n_lbl*4)+2][0];
+        if (n_lbl == 0)
+            lbl0 = lbl;
+        n_lbl++;
+    end // }
+    parse_flat = n_lbl * 4;
+    nxtB       = (pkt.size > (index + parse_flat)) ? pkt[index+parse_flat] : 8'hAA;
+    if ((lbl0 != eth_null_lbl) & (nxtB[7:5] == 3'h0))
+        parse_flat += 4; // eth ctrl word
+    // same nxt hdr selection as unpack_hdr
+    nxt_hid = DATA_HID;
+    if (pkt.size > (index + parse_flat))
+    begin // {
+        if (lbl == ipv4_null_lbl) 
+            nxt_hid = IPV4_HID;
+        if (lbl == ipv6_null_lbl) 
+            nxt_hid = IPV6_HID;
+        if (lbl0 == eth_null_lbl)
+            nxt_hid = ETH_HID;
+        if ((lbl0 != eth_null_lbl) & (nxtB[7:5] == 3'h0))
+            nxt_hid = ETH_HID;
+        if ((lbl != ipv4_null_lbl) & (nxtB[7:4] == 4'h4)) 
+            nxt_hid = IPV4_HID;
+        if ((lbl != ipv6_null_lbl) & (nxtB[7:4] == 4'h6)) 
+            nxt_hid = IPV6_HID;
+    end // }
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     int       nxt_hid;
     bit [7:0] nxtB;
@@ -192,11 +237,10 @@ class mpls_hdr_class extends hdr_class; // {
                break;
             end // }
             `ifdef SVFNYI_0
-            harray.unpack_array (pkt, pack_vec, index, 4);
+            pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
             {label[num_mpls_lbl-1], exp[num_mpls_lbl-1], s[num_mpls_lbl-1], ttl[num_mpls_lbl-1]} = pack_vec;
             `else
-            harray.copy_array (pkt, hdr, index, 4);
-            {>>{label[num_mpls_lbl-1], exp[num_mpls_lbl-1], s[num_mpls_lbl-1], ttl[num_mpls_lbl-1]}} = hdr;
+            `UNPACK_FLDS({label[num_mpls_lbl-1], exp[num_mpls_lbl-1], s[num_mpls_lbl-1], ttl[num_mpls_lbl-1]}, 4);
             `endif
             if (s[num_mpls_lbl-1] == 1'b1)
             begin // {
@@ -215,11 +259,10 @@ class mpls_hdr_class extends hdr_class; // {
     if ((label[0] != eth_null_lbl) & (nxtB[7:5] == 3'h0))
     begin // {
         `ifdef SVFNYI_0
-        harray.unpack_array (pkt, pack_vec, index, 4);
+        pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 4);
         eth_ctrl =  pack_vec;
         `else
-        harray.copy_array (pkt, hdr, index, 4);
-        {>>{eth_ctrl}} =  hdr;
+        `UNPACK_FLDS({eth_ctrl}, 4);
         `endif
         hdr_len  = (num_mpls_lbl * 4) + 4;
     end // }
@@ -257,9 +300,7 @@ class mpls_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -37,6 +37,9 @@ class ptip_hdr_class extends hdr_class; // {
   rand bit [15:0] pt_len;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [7:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
 
@@ -88,6 +91,7 @@ class ptip_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     int tmp_idx;
@@ -95,10 +99,10 @@ class ptip_hdr_class extends hdr_class; // {
     harray.pack_array_8 (pt_data, pkt, tmp_idx);
     index    = (tmp_idx * 8);
     pack_vec = protocol;
-    harray.pack_bit (pkt, pack_vec, index, 8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 8);
     `else
-    hdr = {>>{pt_data, protocol}};
-    harray.pack_array_8 (hdr, pkt, index);
+    harray.pack_array_8 (pt_data, pkt, index);
+    `PACK_FLDS({protocol});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -108,6 +112,7 @@ class ptip_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -115,16 +120,17 @@ class ptip_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, pt_len);
     `ifdef SVFNYI_0
     harray.copy_array (pkt, pt_data, index, hdr_len-1);
-    harray.unpack_array (pkt, pack_vec, index, 1);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 1);
     protocol = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, pt_len);
-    {>>{pt_data, protocol}} = hdr;
+    harray.copy_array (pkt, pt_data, index, pt_len-1);
+    `UNPACK_FLDS({protocol}, 1);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -143,9 +149,7 @@ class ptip_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -37,6 +37,9 @@ class ptl2_hdr_class extends hdr_class; // {
   rand bit [15:0] pt_len;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [15:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
 
@@ -88,6 +91,7 @@ class ptl2_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     int tmp_idx; 
@@ -95,10 +99,10 @@ class ptl2_hdr_class extends hdr_class; // {
     harray.pack_array_8 (pt_data, pkt, tmp_idx);
     index    = (tmp_idx * 8);
     pack_vec = etype;
-    harray.pack_bit (pkt, pack_vec, index, 16);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 16);
     `else
-    hdr = {>>{pt_data, etype}};
-    harray.pack_array_8 (hdr, pkt, index);
+    harray.pack_array_8 (pt_data, pkt, index);
+    `PACK_FLDS({etype});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -108,6 +112,7 @@ class ptl2_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -115,16 +120,17 @@ class ptl2_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, pt_len);
     `ifdef SVFNYI_0
     harray.copy_array (pkt, pt_data, index, hdr_len-2);
-    harray.unpack_array (pkt, pack_vec, index, 2);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 2);
     etype = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{pt_data, etype}} = hdr;
+    harray.copy_array (pkt, pt_data, index, hdr_len-2);
+    `UNPACK_FLDS({etype}, 2);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -143,9 +149,7 @@ class ptl2_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
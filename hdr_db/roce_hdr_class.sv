@@ -47,6 +47,9 @@ class roce_hdr_class extends hdr_class; // {
   rand bit [31:0] icrc;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [31:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
          bit               cal_n_add_icrc = 1'b1;
@@ -84,7 +87,9 @@ class roce_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
-    bit [7:0] icrc_pkt [];
+    `PROF_BEGIN
+    int       msk_off [$];
+    bit [7:0] msk_val [$];
     // pack next hdr
     if (~last_pack)
     begin // {
@@ -97,28 +102,31 @@ class roce_hdr_class extends hdr_class; // {
     // calculate icrc
     if (cal_n_add_icrc)
     begin // {
-        icrc_pkt = new[start_off] (pkt); 
-        // GRH fields : flow_label, tclass, hoplmt and BTH rsvd0 are replaced with 1's for ICRC cal 
+        // GRH fields : flow_label, tclass, hoplmt and BTH rsvd0 are replaced with 1's for ICRC cal,
+        // substituted while crc runs over pkt (no copy)
         if (nxt_hdr.hid === GRH_HID)
         begin // {
-            icrc_pkt [nxt_hdr.start_off]     = {4'h0, 4'hF}; // tclass[7:4]
-            icrc_pkt [nxt_hdr.start_off + 1] = 8'hFF;        // {tclass[3:0], flow_label[19:16]}
-            icrc_pkt [nxt_hdr.start_off + 2] = 8'hFF;        // flow_label[15:8]
-            icrc_pkt [nxt_hdr.start_off + 3] = 8'hFF;        // flow_label[7:0] 
-            icrc_pkt [nxt_hdr.start_off + 7] = 8'hFF;        // hoplmt
-            if (nxt_hdr.nxt_hdr.hid === BTH_HID)             // bth : rsvd0
-                icrc_pkt [nxt_hdr.nxt_hdr.start_off + 4] = 8'hFF;
+            msk_off = '{nxt_hdr.start_off, nxt_hdr.start_off + 1, nxt_hdr.start_off + 2,
+                        nxt_hdr.start_off + 3, nxt_hdr.start_off + 7};
+            msk_val = '{{4'h0, 4'hF}, 8'hFF, 8'hFF, 8'hFF, 8'hFF}; // tclass[7:4], {tclass[3:0], flow_label}, hoplmt
+            if (nxt_hdr.nxt_hdr.hid === BTH_HID)                   // bth : rsvd0
+            begin // {
+                msk_off.push_back (nxt_hdr.nxt_hdr.start_off + 4);
+                msk_val.push_back (8'hFF);
+            end // }
         end // }
-        icrc = crc_chksm.crc32 (icrc_pkt, icrc_pkt.size, nxt_hdr.start_off, corrupt_icrc); 
+        // crc covers start_off bytes from nxt_hdr, ones past icrc are zeros (as with earlier icrc copy)
+        icrc = crc_chksm.crc32_masked (pkt, start_off - nxt_hdr.start_off, nxt_hdr.start_off,
+                                       msk_off, msk_val, corrupt_icrc, nxt_hdr.start_off);
     end // }
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = icrc;
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{icrc}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({icrc});
     `endif
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -126,6 +134,7 @@ class roce_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // get next hdr and update common nxt_hdr fields
     update_len (index, pkt.size, 0, 4);
@@ -145,21 +154,18 @@ class roce_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
     // unpack class members
     start_off = index;
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, trl_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, trl_len);
     icrc = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, trl_len);
-    {>>{icrc}} = hdr;
+    `UNPACK_FLDS({icrc}, trl_len);
     `endif
     `ifdef DEBUG_PKTLIB
     $display ("    pkt_lib : Unpacking %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index); 
     `endif
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
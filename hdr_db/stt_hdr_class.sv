@@ -82,6 +82,9 @@ class stt_hdr_class extends hdr_class; // {
   rand bit [15:0]    pad;           
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [143:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           corrupt_stt_version = 1'b0;
@@ -150,18 +153,18 @@ class stt_hdr_class extends hdr_class; // {
     int i;
     super.post_randomize();
     ip_found  = 1'b0;
-    for (i = this.cfg_id+1; i < super.all_hdr.size; i++)
+    for (i = this.cfg_id+1; i < super.hdr_stk.all_hdr.size; i++)
     begin // {
         // Calculate flags[2] and l4_offset
-        if (~ip_found & ((super.all_hdr[i].hid == IPV4_HID) | (super.all_hdr[i].hid == IPV6_HID)))
+        if (~ip_found & ((super.hdr_stk.all_hdr[i].hid == IPV4_HID) | (super.hdr_stk.all_hdr[i].hid == IPV6_HID)))
         begin // {
             ip_found = 1'b1;
-            flags[2] = cal_flag2 & (super.all_hdr[i].hid == IPV4_HID);
+            flags[2] = cal_flag2 & (super.hdr_stk.all_hdr[i].hid == IPV4_HID);
             if (cal_l4_offset)
-                l4_offset = this.nxt_hdr.total_hdr_len - super.all_hdr[i].nxt_hdr.total_hdr_len;
+                l4_offset = this.nxt_hdr.total_hdr_len - super.hdr_stk.all_hdr[i].nxt_hdr.total_hdr_len;
         end // }
         // Calculate flags[3]
-        if (super.all_hdr[i].hid == TCP_HID)
+        if (super.hdr_stk.all_hdr[i].hid == TCP_HID)
         begin // {
             flags[3] = cal_flag3;
             break;
@@ -172,13 +175,13 @@ class stt_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad};       
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -188,22 +191,30 @@ class stt_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    nxt_hid = ETH_HID;
+    return 18;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 18);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad}} = hdr;
+    `UNPACK_FLDS({version, flags, l4_offset, rsvd, max_seg_sz, PCP, V, vlan, ctx_id, pad}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -222,9 +233,7 @@ class stt_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -87,6 +87,9 @@ class tcp_hdr_class extends hdr_class; // {
   rand  bit [7:0]     options [];
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [159:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
         bit           corrupt_offset        = 1'b0;
@@ -174,9 +177,33 @@ class tcp_hdr_class extends hdr_class; // {
     end // }
   endfunction : post_randomize // }
 
+  function bit fast_randomize (); // {
+    if (corrupt_offset)
+        offset = $urandom_range (4, 0);
+    else
+        offset = $urandom_range (15, 5);
+    hdr_len    = (offset > 4'h4) ? offset*4 : 20;
+    trl_len    = 0;
+    src_prt    = $urandom;
+    dst_prt    = get_fast_tcp_dst_prt (nxt_hdr.hid);
+    seq_number = $urandom;
+    ack_number = $urandom;
+    rsvd       = null_rsvd ? 4'h0 : $urandom;
+    flags      = $urandom;
+    {cwr, ece, urg, ack, psh, rst, syn, fin} = flags;
+    {window, urgent_ptr} = $urandom;
+    checksum   = 16'h0;
+    options    = new [(offset > 4'h5) ? (offset-5)*4 : 0];
+    if (harray.data_pattern == "RND")
+        harray.fill_array (options);
+    post_randomize ();
+    return 1'b1;
+  endfunction : fast_randomize // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int tcp_idx, tmp_idx;
     tcp_idx = index;
     // making sure checksum is 0, incase pack_hdr was called before radomization
@@ -185,7 +212,7 @@ class tcp_hdr_class extends hdr_class; // {
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr};
-    harray.pack_bit (pkt, pack_vec, index, 160);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 160);
     if (offset > 5)
     begin // {
         tmp_idx = index / 8;
@@ -193,11 +220,9 @@ class tcp_hdr_class extends hdr_class; // {
         index  = tmp_idx * 8;
     end // }
     `else
+    `PACK_FLDS({src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr});
     if (offset > 5)
-        hdr = {>>{src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr, options}};
-    else
-        hdr = {>>{src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr}};
-    harray.pack_array_8 (hdr, pkt, index);
+        harray.pack_array_8 (options, pkt, index);
     `endif
     // pack next hdr
     if (~last_pack)
@@ -210,22 +235,32 @@ class tcp_hdr_class extends hdr_class; // {
     // checksum calulation
     if (~last_pack)
         post_pack (pkt, tcp_idx);
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 20))
+        return -1;
+    nxt_hid = get_hid_from_tcp_dst_prt ({pkt[index+2], pkt[index+3]});
+    return (pkt[index+12][7:4] * 4);
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 20);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr}} = hdr;
+    `UNPACK_FLDS({src_prt, dst_prt, seq_number, ack_number, offset, rsvd, flags, window, checksum, urgent_ptr}, hdr_len);
     `endif
     hdr_len   = offset * 4;
     if (offset > 4'd5)
@@ -247,65 +282,26 @@ class tcp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref bit [7:0] pkt [],
                           int       tcp_idx); // {
-    bit [7:0]      chksm_data [];
-    bit [15:0]     pseudo_chksm;
-    int            i, idx;
-    ipv4_hdr_class lcl_ip4;
-    ipv6_hdr_class lcl_ip6;
-    grh_hdr_class  lcl_grh;
-    // Calulate tcp_chksm, corrupt it if asked
+    `PROF_BEGIN
+    int idx;
+    `ifdef SVFNYI_0
+    idx = tcp_idx/8;
+    `else
+    idx = tcp_idx;
+    `endif
+    // Calulate tcp_chksm on pkt directly, corrupt it if asked
     if (cal_tcp_chksm)
-    begin // {
-        for (i = 0; i < this.cfg_id; i++)
-        begin // {
-            if (super.all_hdr[i].hid == IPV4_HID)
-            begin // {
-                lcl_ip4 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip4, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip4.pseudo_chksm;
-            end // }
-            if (super.all_hdr[i].hid == IPV6_HID)
-            begin // {
-                lcl_ip6 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip6, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip6.pseudo_chksm;
-            end // }
-            if (super.all_hdr[i].hid == GRH_HID)
-            begin // {
-                lcl_grh = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_grh, super.all_hdr[i]);
-                pseudo_chksm = lcl_grh.pseudo_chksm;
-            end // }
-        end // }
-        `ifdef SVFNYI_0
-        idx = tcp_idx/8;
-        `else
-        idx = tcp_idx;
-        `endif
-        harray.copy_array(pkt, chksm_data, idx, (pkt.size - tcp_idx));
-        if (chksm_data.size%2 != 0)
-        begin // {
-            chksm_data                      = new [chksm_data.size + 1] (chksm_data);
-            chksm_data [chksm_data.size -1] = 8'h00;
-        end // }
-        checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_tcp_chksm, corrupt_tcp_chksm_msk, pseudo_chksm);
-        pack_hdr (pkt, tcp_idx, 1'b1);
-    end // }
-    else
-    begin // {
-        if (corrupt_tcp_chksm)
-        begin // {
-            checksum ^= corrupt_tcp_chksm_msk;
-            pack_hdr (pkt, tcp_idx, 1'b1);
-        end // }
-    end // }
+        checksum = crc_chksm.chksm16_slice(pkt, idx, (pkt.size - idx), corrupt_tcp_chksm, corrupt_tcp_chksm_msk, get_pseudo_sum ());
+    else if (corrupt_tcp_chksm)
+        checksum ^= corrupt_tcp_chksm_msk;
+    if (cal_tcp_chksm | corrupt_tcp_chksm)
+        {pkt[idx+16], pkt[idx+17]} = checksum;
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -54,7 +54,10 @@ class toh_class extends hdr_class; // {
   rand   bit [31:0]        crc32;       
   rand   bit [15:0]        crc16;
   rand   bit [15:0]        pad_len;
-  rand   bit [7:0]         pad_data [];
+  rand   bit [7:0]         pad_data [];                  // solved only if use_solver, else filled in post_randomize
+  rand   bit [63:0]        prng_seed;                    // seeds harray PRNG for data_pattern "RND"
+         bit               pad_view = 1'b0;              // pad_data is still a view at pad_off of plib pkt (see view_byte)
+         int               pad_off;
 
   // ~~~~~~~~~~ Contol variables ~~~~~~~~~~
          bit               cal_n_add_crc    = 1'b1;
@@ -95,7 +98,7 @@ class toh_class extends hdr_class; // {
   {
      (rnd_pad_en   == 1'b1) -> pad_len inside { [16'd0 : max_pad_len] };
      (rnd_pad_en   == 1'b0) -> pad_len == usr_pad;
-     pad_data.size == pad_len;
+     use_solver -> pad_data.size == pad_len;
   }
 
   constraint legal_chop_plen
@@ -116,16 +119,53 @@ class toh_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  // pad_data is kept out of solver unless use_solver is set
+  function void pre_randomize (); // {
+    super.pre_randomize();
+    pad_data.rand_mode (use_solver);
+  endfunction : pre_randomize // }
+
+  function void post_randomize (); // {
+    super.post_randomize();
+    pad_view = 1'b0;
+    if (~use_solver)
+    begin // {
+        // pad is kept out of solver, fill it in bulk
+        pad_data = new [pad_len];
+        harray.seed_prng (prng_seed, 1'b0);
+        harray.fill_array (pad_data);
+    end // }
+    else if (harray.data_pattern != "RND")
+        harray.fill_array (pad_data);
+  endfunction : post_randomize // }
+
+  function bit fast_randomize (); // {
+    if ((chop_plen_to != 0) & (chop_plen_to < (min_chop_plen + crc_sz)))
+        return 1'b0;
+    pad_len  = rnd_pad_en ? $urandom_range (max_pad_len, 0) : usr_pad;
+    prng_seed = {$urandom, $urandom};
+    post_randomize ();
+    crc32    = $urandom;
+    crc16    = $urandom;
+    hdr_len  = 0;
+    trl_len  = 0;
+    return 1'b1;
+  endfunction : fast_randomize // }
+
+  function void fast_post_len (); // {
+    plen = total_hdr_len + pad_len;
+  endfunction : fast_post_len // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int i; 
-    `ifdef SVFNYI_0
-    bit [`VEC_SZ-1:0] tmp_vec;
-    `endif
 
-    // pack all the hdrs to pkt
-    pkt      = new[this.plen];
+    // Get crc_sz if CRC need to be appended. plen already covers ICV/ESP
+    // trailers (trl_len), so the final frame is allocated once with room for CRC
+    crc_sz   = get_crc_sz;
+    pkt      = new[this.plen + crc_sz];
     index    = 0;
     `ifdef DEBUG_PKTLIB
     $display ("    pkt_lib : Packing %s nxt_hdr %s index %0d", hdr_name, nxt_hdr.hdr_name, index);
@@ -133,19 +173,14 @@ class toh_class extends hdr_class; // {
     this.nxt_hdr.pack_hdr (pkt, index);
 
     // pad pkt
+    fetch_view ();
     if (pad_len != 0)
-    begin // {
-        if (harray.data_pattern != "RND")
-            harray.fill_array(pad_data);
         harray.pack_array_8 (pad_data, pkt, index);
-    end // }
 
-    // CRC will get appended here. Get crc_sz if CRC need to be appended
-    crc_sz = get_crc_sz;
+    // CRC will get appended here
     plen += crc_sz;
-    pkt   = new [this.plen] (pkt);
 
-    // chop pkt
+    // chop pkt. Checksums are already done on the full pkt, so only shrink here
     if ((chop_plen_to != 0) & (chop_plen_to < (plen - crc_sz)))
     begin // {
         pkt = new[chop_plen_to] (pkt);
@@ -160,27 +195,23 @@ class toh_class extends hdr_class; // {
     if (cal_n_add_crc & (crc_sz != 0))
     begin // {
         for (i = crc_sz; i > 0; i--)
-            pkt[pkt.size() - crc_sz] = 0;
+            pkt[pkt.size() - i] = 0;
         if (crc_sz == 4)
         begin // {
             crc32   = crc_chksm.crc32(pkt, pkt.size()-crc_sz, 0, corrupt_crc);
             `ifdef SVFNYI_0
-            tmp_vec = crc32;
-            this.nxt_hdr.harray.pack_bit(pkt, tmp_vec, index, crc_sz*8);
+            pktlib_vec_class #(32)::pack_bit (pkt, crc32, index);
             `else
-            hdr     = {>>{crc32}};
-            this.nxt_hdr.harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({crc32});
             `endif
         end // }
         else
         begin // {
             crc16   = crc_chksm.crc32(pkt, pkt.size()-crc_sz, 0, corrupt_crc);
             `ifdef SVFNYI_0
-            tmp_vec = crc16;
-            this.nxt_hdr.harray.pack_bit(pkt, tmp_vec, index, crc_sz*8);
+            pktlib_vec_class #(16)::pack_bit (pkt, crc16, index);
             `else
-            hdr     = {>>{crc16}};
-            this.nxt_hdr.harray.pack_array_8 (hdr, pkt, index);
+            `PACK_FLDS({crc16});
             `endif
         end // }
     end // }
@@ -188,6 +219,7 @@ class toh_class extends hdr_class; // {
     $display ("    pkt_lib : Done Packing %s index %0d", hdr_name, index);
     `endif
 
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -195,6 +227,7 @@ class toh_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     int        idx_eoh = 0;
     data_class lcl_data;
 
@@ -225,9 +258,20 @@ class toh_class extends hdr_class; // {
     if (pad_len != 0)
     begin // {
         index = (pkt.size-pad_len);
-        this.nxt_hdr.harray.copy_array (pkt, pad_data, index, pad_len);
-        pkt   = new [pkt.size - pad_len] (pkt);
-        index  = pkt.size;
+        if (plib.data_view)
+        begin // {
+            // pad is left as view in pkt instead of chopping pkt
+            pad_view = 1'b1;
+            pad_off  = index;
+            pad_data = null_a;
+        end // }
+        else
+        begin // {
+            pad_view = 1'b0;
+            this.nxt_hdr.harray.copy_array (pkt, pad_data, index, pad_len);
+            pkt   = new [pkt.size - pad_len] (pkt);
+            index  = pkt.size;
+        end // }
     end // }
 
     // adjusting data[0].data_len due to CRC and pad
@@ -244,6 +288,7 @@ class toh_class extends hdr_class; // {
                     lcl_data.data_len     -= (idx_eoh - index);
                     lcl_data.hdr_len       = lcl_data.data_len; 
                     lcl_data.total_hdr_len = lcl_data.data_len; 
+                    if (~lcl_data.is_view)
                     lcl_data.data          = new [lcl_data.data_len] (lcl_data.data);
                 end // }
             end // }
@@ -254,16 +299,25 @@ class toh_class extends hdr_class; // {
     $display ("    pkt_lib : Done Unpacking %s  index %0d", hdr_name, index);
     `endif
 
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
+  function void fetch_view (); // {
+    if (pad_view)
+    begin // {
+        pad_data = new [pad_len];
+        foreach (pad_data[i])
+            pad_data[i] = plib.view_byte (pad_off + i);
+        pad_view = 1'b0;
+    end // }
+  endfunction : fetch_view // }
+
   task cpy_hdr (hdr_class cpy_cls,
                 bit       last_cpy = 1'b0); // {
     toh_class lcl;
     super.cpy_hdr (cpy_cls);
     $cast (lcl, cpy_cls);
+    lcl.fetch_view ();
     // ~~~~~~~~~~ Random variables ~~~~~~~~~~
     this.plen             = lcl.plen;
     this.crc32            = lcl.crc32;
@@ -294,6 +348,12 @@ class toh_class extends hdr_class; // {
     string crc_string;
     toh_class lcl;
     $cast (lcl, cmp_cls);
+    // FIELD_MAP only needs pad_len, pad view is not fetched
+    if (mode != FIELD_MAP)
+    begin // {
+        fetch_view ();
+        lcl.fetch_view ();
+    end // }
     if ((mode == DISPLAY_FULL) | (mode == COMPARE_FULL))
     hdis.display_fld (mode, hdr_name, STRING,     DEF, 000, "", 0, 0, null_a, null_a, "~~~~~~~~~~ Random Variables ~~~~~~~");
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "plen", plen, lcl.plen);
@@ -301,7 +361,9 @@ class toh_class extends hdr_class; // {
     if (~last_display & (cmp_cls.nxt_hdr.hid === nxt_hdr.hid))
         this.nxt_hdr.display_hdr (hdis, cmp_cls.nxt_hdr, mode);
     hdis.display_fld (mode, hdr_name, BIT_VEC_NH, DEF, 032, "pad_len", pad_len, lcl.pad_len);
-    if (pad_len != 0)
+    if ((pad_len != 0) & pad_view)
+    hdis.display_fld (mode, hdr_name, BIT_VEC,    DEF, pad_len*8, "pad_data", 0, 0);
+    else if (pad_len != 0)
     hdis.display_fld (mode, hdr_name, ARRAY,      DEF, 000,  "pad_data", 0, 0, pad_data, lcl.pad_data);
     if (cal_n_add_crc)
     begin // {
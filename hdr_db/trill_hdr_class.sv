@@ -57,6 +57,9 @@ class trill_hdr_class extends hdr_class; // {
   rand bit [7:0]     options[];
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [47:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           corrupt_trill_version = 1'b0;
@@ -110,11 +113,12 @@ class trill_hdr_class extends hdr_class; // {
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     int tmp_idx;
     pack_vec = {V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname}; 
-    harray.pack_bit (pkt, pack_vec, index, 48);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, 48);
     if (op_length > 0)
     begin // {
         tmp_idx = index/8;
@@ -122,11 +126,9 @@ class trill_hdr_class extends hdr_class; // {
         index = tmp_idx * 8;
     end // }
     `else
+    `PACK_FLDS({V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname});
     if (op_length > 5'd0)
-        hdr = {>>{V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname, options}};
-    else
-        hdr = {>>{V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname}};
-    harray.pack_array_8 (hdr, pkt, index);
+        harray.pack_array_8 (options, pkt, index);
     `endif
     // pack next hdr
     if (~last_pack)
@@ -136,6 +138,7 @@ class trill_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -143,15 +146,15 @@ class trill_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 6);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, 6);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, 6);
     {V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, 6);
-    {>>{V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname}} = hdr;
+    `UNPACK_FLDS({V, R, M, op_length, hop_count, egr_rb_nname, igr_rb_nname}, 6);
     `endif
     hdr_len   = 6 + op_length*4;
     if (op_length > 5'd0)
@@ -173,9 +176,7 @@ class trill_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -51,6 +51,9 @@ class udp_hdr_class extends hdr_class; // {
   rand  bit [15:0]    checksum;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
         bit           cal_length            = 1'b1;
@@ -104,9 +107,26 @@ class udp_hdr_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  function bit fast_randomize (); // {
+    src_prt  = $urandom;
+    dst_prt  = get_fast_udp_dst_prt (nxt_hdr.hid);
+    checksum = 16'h0;
+    if (~cal_length)
+        length = $urandom;
+    hdr_len  = 8;
+    trl_len  = 0;
+    return 1'b1;
+  endfunction : fast_randomize // }
+
+  function void fast_post_len (); // {
+    if (cal_length)
+        length = total_hdr_len;
+  endfunction : fast_post_len // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     int udp_idx;
     udp_idx = index;
     // making sure checksum is 0, incase pack_hdr was called before radomization
@@ -115,10 +135,9 @@ class udp_hdr_class extends hdr_class; // {
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {src_prt, dst_prt, length, checksum};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{src_prt, dst_prt, length, checksum}};  
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({src_prt, dst_prt, length, checksum});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -130,22 +149,32 @@ class udp_hdr_class extends hdr_class; // {
     end // }
     if (~last_pack)
         post_pack (pkt, udp_idx);
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    if (pkt.size < (index + 8))
+        return -1;
+    nxt_hid = get_hid_from_udp_dst_prt ({pkt[index+2], pkt[index+3]});
+    return 8;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {src_prt, dst_prt, length, checksum} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{src_prt, dst_prt, length, checksum}} = hdr;
+    `UNPACK_FLDS({src_prt, dst_prt, length, checksum}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -164,65 +193,26 @@ class udp_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task post_pack (ref bit [7:0] pkt [],
                           int       udp_idx); // {
-    bit [7:0]      chksm_data [];
-    bit [15:0]     pseudo_chksm;
-    int            i, idx;
-    ipv4_hdr_class lcl_ip4;
-    ipv6_hdr_class lcl_ip6;
-    grh_hdr_class  lcl_grh;
-    // Calulate udp_chksm, corrupt it if asked
+    `PROF_BEGIN
+    int idx;
+    `ifdef SVFNYI_0
+    idx = udp_idx/8;
+    `else
+    idx = udp_idx;
+    `endif
+    // Calulate udp_chksm on pkt directly, corrupt it if asked
     if (cal_udp_chksm)
-    begin // {
-        for (i = 0; i < this.cfg_id; i++)
-        begin // {
-            if (super.all_hdr[i].hid == IPV4_HID)
-            begin // {
-                lcl_ip4 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip4, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip4.pseudo_chksm;
-            end // }
-            if (super.all_hdr[i].hid == IPV6_HID)
-            begin // {
-                lcl_ip6 = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_ip6, super.all_hdr[i]);
-                pseudo_chksm = lcl_ip6.pseudo_chksm;
-            end // }
-            if (super.all_hdr[i].hid == GRH_HID)
-            begin // {
-                lcl_grh = new (super.plib, `MAX_NUM_INSTS+1);
-                $cast (lcl_grh, super.all_hdr[i]);
-                pseudo_chksm = lcl_grh.pseudo_chksm;
-            end // }
-        end // }
-        `ifdef SVFNYI_0
-        idx = udp_idx/8;;
-        `else
-        idx = udp_idx;
-        `endif
-        harray.copy_array(pkt, chksm_data, idx, (pkt.size - udp_idx));
-        if (chksm_data.size%2 != 0)
-        begin // {
-            chksm_data                      = new [chksm_data.size + 1] (chksm_data);
-            chksm_data [chksm_data.size -1] = 8'h00;
-        end // }
-        checksum = crc_chksm.chksm16(chksm_data, chksm_data.size(), 0, corrupt_udp_chksm, corrupt_udp_chksm_msk, pseudo_chksm);
-        pack_hdr (pkt, udp_idx, 1'b1);
-    end // }
-    else
-    begin // {
-        if (corrupt_udp_chksm)
-        begin // {
-            checksum ^= corrupt_udp_chksm_msk;
-            pack_hdr (pkt, udp_idx, 1'b1);
-        end // }
-    end // }
+        checksum = crc_chksm.chksm16_slice(pkt, idx, (pkt.size - idx), corrupt_udp_chksm, corrupt_udp_chksm_msk, get_pseudo_sum ());
+    else if (corrupt_udp_chksm)
+        checksum ^= corrupt_udp_chksm_msk;
+    if (cal_udp_chksm | corrupt_udp_chksm)
+        {pkt[idx+6], pkt[idx+7]} = checksum;
+    `PROF_END ("post_pack", hdr_name)
   endtask : post_pack // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -58,6 +58,9 @@ class vntag_hdr_class extends hdr_class; // {
   rand bit [15:0] etype;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [47:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
        bit        corrupt_vntag_ver = 1'b0;
        bit        null_rsvd         = 1'b0;
 
@@ -110,13 +113,13 @@ class vntag_hdr_class extends hdr_class; // {
   task pack_hdr(ref   bit [7:0] pkt [],
                 ref   int       index,
                 input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {d, p, dst_vif, l, rsvd, ver, src_vif, etype};
-    harray.pack_bit(pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{d, p, dst_vif, l, rsvd, ver, src_vif, etype}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({d, p, dst_vif, l, rsvd, ver, src_vif, etype});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -126,6 +129,7 @@ class vntag_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
   task unpack_hdr (ref   bit [7:0] pkt   [],
@@ -133,15 +137,15 @@ class vntag_hdr_class extends hdr_class; // {
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class lcl_class;
     // unpack class members
     update_len (index, pkt.size, 6); 
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {d, p, dst_vif, l, rsvd, ver, src_vif, etype} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{d, p, dst_vif, l, rsvd, ver, src_vif, etype}} = hdr;
+    `UNPACK_FLDS({d, p, dst_vif, l, rsvd, ver, src_vif, etype}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -160,9 +164,7 @@ class vntag_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
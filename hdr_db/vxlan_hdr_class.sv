@@ -46,6 +46,9 @@ class vxlan_hdr_class extends hdr_class; // {
   rand bit [7:0]     rsvd1;
 
   // ~~~~~~~~~~ Local Variables ~~~~~~~~~~
+  `ifdef SVFNYI_0
+         bit [63:0]  pack_vec; // packing vector, width of all hdr fields
+  `endif
 
   // ~~~~~~~~~~ Control variables ~~~~~~~~~~
        bit           null_rsvd         = 1'b0;
@@ -86,16 +89,26 @@ class vxlan_hdr_class extends hdr_class; // {
     super.update_hdr_db (hid, inst_no);
   endfunction : new // }
 
+  function bit fast_randomize (); // {
+    {R1, I, R2, rsvd0} = $urandom;
+    {vni, rsvd1}       = $urandom;
+    if (null_rsvd)
+        {R1, R2, rsvd0, rsvd1} = 0;
+    hdr_len = 8;
+    trl_len = 0;
+    return 1'b1;
+  endfunction : fast_randomize // }
+
   task pack_hdr (ref   bit [7:0] pkt [],
                  ref   int       index,
                  input bit       last_pack = 1'b0); // {
+    `PROF_BEGIN
     // pack class members
     `ifdef SVFNYI_0
     pack_vec = {R1, I, R2, rsvd0, vni, rsvd1};
-    harray.pack_bit (pkt, pack_vec, index, hdr_len*8);
+    pktlib_vec_class #($bits(pack_vec))::pack_bit (pkt, pack_vec, index, hdr_len*8);
     `else
-    hdr = {>>{R1, I, R2, rsvd0, vni, rsvd1}};
-    harray.pack_array_8 (hdr, pkt, index);
+    `PACK_FLDS({R1, I, R2, rsvd0, vni, rsvd1});
     `endif
     // pack next hdr
     if (~last_pack)
@@ -105,22 +118,30 @@ class vxlan_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.pack_hdr (pkt, index);
     end // }
+    `PROF_END ("pack_hdr", hdr_name)
   endtask : pack_hdr // }
 
+  function int parse_flat (ref   bit [7:0] pkt [],
+                           input int       index,
+                           output int      nxt_hid); // {
+    nxt_hid = ETH_HID;
+    return 8;
+  endfunction : parse_flat // }
+
   task unpack_hdr (ref   bit [7:0] pkt   [],
                    ref   int       index,
                    ref   hdr_class hdr_q [$],
                    input int       mode        = DUMB_UNPACK,
                    input bit       last_unpack = 1'b0); // {
+    `PROF_BEGIN
     hdr_class  lcl_class;
     // unpack class members
     update_len (index, pkt.size, 8);
     `ifdef SVFNYI_0
-    harray.unpack_array (pkt, pack_vec, index, hdr_len);
+    pktlib_vec_class #($bits(pack_vec))::unpack_array (pkt, pack_vec, index, hdr_len);
     {R1, I, R2, rsvd0, vni, rsvd1} = pack_vec;
     `else
-    harray.copy_array (pkt, hdr, index, hdr_len);
-    {>>{R1, I, R2, rsvd0, vni, rsvd1}} = hdr;
+    `UNPACK_FLDS({R1, I, R2, rsvd0, vni, rsvd1}, hdr_len);
     `endif
     // get next hdr and update common nxt_hdr fields
     if (mode == SMART_UNPACK)
@@ -139,9 +160,7 @@ class vxlan_hdr_class extends hdr_class; // {
         `endif
         this.nxt_hdr.unpack_hdr (pkt, index, hdr_q, mode);
     end // }
-    // update all hdr
-    if (mode == SMART_UNPACK)
-        super.all_hdr = hdr_q;
+    `PROF_END ("unpack_hdr", hdr_name)
   endtask : unpack_hdr // }
 
   task cpy_hdr (hdr_class cpy_cls,
@@ -28,16 +28,18 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //  |        |         |               |          i.e. {start_byte,       |
 //  |        |         |               |                ~start_byte, ...} |
 //  |        |         |               | "FIX" -> Fix start_byte data     |
-//  |        |         |               | "RND" -> Random data             |
+//  |        |         |               | "RND" -> Random data (PRNG)      |
 //  +--------+---------+---------------+----------------------------------+
 //
 // ----------------------------------------------------------------------
 
-class pktlib_array_class;
+class pktlib_array_class extends pktlib_object_class;
 
   // ~~~~~~~~~~ control variables ~~~~~~~~~~
     string     data_pattern = "RND";
     bit [7:0]  start_byte   = 8'h00;
+    longint unsigned prng_st [4];        // payload PRNG state of this array class, see seed_prng
+    bit              prng_fix = 1'b0;    // prng_st seeded by user, hdr randomize doesn't reseed it
 
   function new (input string     data_pattern = "RND",
                 input bit [7:0]  start_byte   = 8'h00); // {
@@ -45,6 +47,10 @@ class pktlib_array_class;
     this.start_byte   = start_byte;
   endfunction : new // }
 
+  function string obj_type (); // {
+    return "pktlib_array_class";
+  endfunction : obj_type // }
+
   // this task converts bit vector into pkt array of 8 bit
   task pack_bit (ref   bit [7:0]         pkt [],         // Output array
                  input bit [`VEC_SZ-1:0] bit_vec,        // bit vector to pack 
@@ -70,10 +76,10 @@ class pktlib_array_class;
   endtask : pack_bit // }
 
   // this tasks replaces bytes of pkt array from start offset with array_8
-  task pack_array_8 (input bit [7:0] array_8 [],
-                     ref   bit [7:0] pkt     [],
-                     ref   int       start_offset,   // starting offset in bytes 
-                     input bit       no_icr = 1'b0); // don't increment start_offset if 1 {
+  task pack_array_8 (const ref bit [7:0] array_8 [],
+                     ref       bit [7:0] pkt     [],
+                     ref       int       start_offset,   // starting offset in bytes 
+                     input     bit       no_icr = 1'b0); // don't increment start_offset if 1 {
     foreach (array_8[a_ls])
         pkt [start_offset + a_ls] = array_8[a_ls];
     if (~no_icr)
@@ -81,34 +87,27 @@ class pktlib_array_class;
   endtask : pack_array_8 // }
 
   // this tasks converts 8 byte array into unpack vector
-  task unpack_array (input bit [7:0]         array_8 [],
-                     ref   bit [`VEC_SZ-1:0] unpack_vec,
-                     ref   int               start_offset,
-                     input int               length,         // how much data to unpack 
-                     input bit               no_icr = 1'b0); // don't increment start_offset if 1 {
-    int i;
-    for (i = start_offset; i < start_offset+length; i++)
+  task unpack_array (const ref bit [7:0]         array_8 [],
+                     ref       bit [`VEC_SZ-1:0] unpack_vec,
+                     ref       int               start_offset,
+                     input     int               length,         // how much data to unpack 
+                     input     bit               no_icr = 1'b0); // don't increment start_offset if 1 {
+    unpack_vec = unpack_vec << (length*8);
+    for (int i = 0; i < length; i++)
     begin // {
-        unpack_vec = unpack_vec << 8;
-        if (i < array_8.size)
-        begin // {
-            unpack_vec[7:0] = array_8[i];
-        end // }
-        else
-        begin // {
-            unpack_vec[7:0] = 8'h0;
-        end // }
+        if ((start_offset + i) < array_8.size)
+            unpack_vec[(length - 1 - i)*8 +: 8] = array_8[start_offset + i];
     end // }
     if (~no_icr)
         start_offset += length; 
   endtask : unpack_array // }
 
   // this function copies m to n bytes of an array into new array
-  function void copy_array (input bit [7:0] copy_from [],
-                            ref   bit [7:0] copy_to   [],
-                            ref   int       start_offset,
-                            input int       length,    
-                            input bit       no_icr = 1'b0); // {
+  function void copy_array (const ref bit [7:0] copy_from [],
+                            ref       bit [7:0] copy_to   [],
+                            ref       int       start_offset,
+                            input     int       length,    
+                            input     bit       no_icr = 1'b0); // {
     if (length > 0)
     begin // {
         copy_to = new [length];
@@ -122,33 +121,53 @@ class pktlib_array_class;
         start_offset += length; 
   endfunction : copy_array // }
 
-  // function to fill data array
+  // function to fill data array, one loop per pattern
   function  void fill_array (ref   bit [7:0]  data []); // {
-    bit [7:0] fill_byte;
-    int       cnt;
-    fill_byte  = start_byte;
-    for (cnt = 0; cnt < data.size(); cnt++)
+    case (data_pattern) // {
+        "INC"   : foreach (data[cnt]) data[cnt] = start_byte + cnt;
+        "DEC"   : foreach (data[cnt]) data[cnt] = start_byte - cnt;
+        "INV"   : foreach (data[cnt]) data[cnt] = cnt[0] ? ~start_byte : start_byte;
+        "FIX"   : foreach (data[cnt]) data[cnt] = start_byte;
+        default : fill_rnd (data);
+    endcase // }
+  endfunction : fill_array // }
+
+  // function to seed payload PRNG of this array class, same seed gives same
+  // random data. data/toh reseed it from their own RNG in post_randomize
+  // (fix = 0), so srandom of pktlib reproduces payload too. A user seed
+  // (fix = 1) is kept over randomize
+  function void seed_prng (bit [63:0] seed,
+                           bit        fix = 1'b1); // {
+    if (~fix & prng_fix)
+        return;
+    prng_fix |= fix;
+    `ifdef PKTLIB_DPI_PRNG
+    pv_prng_seed (prng_st, seed);
+    `else
+    prng_st[0] = (seed == 0) ? 64'h9e3779b97f4a7c15 : seed;
+    `endif
+  endfunction : seed_prng // }
+
+  // function to fill data array with random bytes, 8 bytes per PRNG step.
+  // Native xoshiro256** with PKTLIB_DPI_PRNG, xorshift64* otherwise. Never
+  // seeded arrays (ex: options filled by fast_randomize) take $urandom
+  function void fill_rnd (ref bit [7:0] data []); // {
+    bit [63:0] rnd;
+    if ((prng_st[0] | prng_st[1] | prng_st[2] | prng_st[3]) == 0)
+        seed_prng ({$urandom, $urandom}, 1'b0);
+    `ifdef PKTLIB_DPI_PRNG
+    pv_prng_fill (prng_st, data, data.size);
+    `else
+    for (int i = 0; i < data.size; i += 8)
     begin // {
-         case (data_pattern) // {
-              "INC"   :
-              begin // {
-                  data[cnt] = fill_byte;
-                  fill_byte = fill_byte + 1;
-              end // }
-              "DEC"   :
-              begin // {
-                  data[cnt] = fill_byte;
-                  fill_byte = fill_byte - 1;
-              end // }
-              "INV"   :
-              begin // {
-                  data[cnt] = fill_byte;
-                  fill_byte = ~fill_byte;
-              end // }
-              "FIX"   : data[cnt] = start_byte;
-              default : data[cnt] = $urandom();
-         endcase // }
+        prng_st[0] ^= prng_st[0] >> 12;
+        prng_st[0] ^= prng_st[0] << 25;
+        prng_st[0] ^= prng_st[0] >> 27;
+        rnd = prng_st[0] * 64'h2545f4914f6cdd1d;
+        for (int j = 0; (j < 8) & ((i + j) < data.size); j++)
+            data[i+j] = rnd[j*8 +: 8];
     end // }
-  endfunction : fill_array // }
+    `endif
+  endfunction : fill_rnd // }
     
 endclass : pktlib_array_class // }
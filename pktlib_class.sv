@@ -36,10 +36,32 @@ class pktlib_class extends pktlib_main_class; // {
     `NEW_HDR;
   endfunction : new // }
 
+  // This task returns a new pktlib with a COPY_DEEP of present hdrs, no
+  // hdr object is shared with this pktlib
+  task clone (output pktlib_class cln); // {
+    cln = new ();
+    cln.cpy_hdr (this, COPY_DEEP);
+  endtask : clone // }
+
   function void pre_randomize (); // {
+    super.pre_randomize ();
   endfunction : pre_randomize // }
 
   function void post_randomize (); // {
+    super.post_randomize ();
   endfunction : post_randomize // }
 
 endclass : pktlib_class // }
+
+`ifdef PKTLIB_DPI_PROF
+  // stage profile at end of simulation, +pktlib_prof_csv=<file> also writes csv
+  final
+  begin // {
+    string prof_csv = "";
+    if (pktlib_prof_class::prf_en)
+    begin // {
+        void'($value$plusargs ("pktlib_prof_csv=%s", prof_csv));
+        pktlib_prof_class::report (0, prof_csv);
+    end // }
+  end // }
+`endif
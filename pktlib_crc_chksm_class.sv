@@ -15,16 +15,44 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //  class to compute crc and checksum
 // ----------------------------------------------------------------------
 
-class pktlib_crc_chksm_class; // {
+class pktlib_crc_chksm_class extends pktlib_object_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  static bit [31:0] crc32_tbl [256];        // reflected crc32 table, shared by all instances
+  static bit        crc32_tbl_vld = 1'b0;
 
    function new (); // {
    endfunction : new // }
 
+  function string obj_type (); // {
+    return "pktlib_crc_chksm_class";
+  endfunction : obj_type // }
+
+  function int obj_bytes (); // {
+    return 32;
+  endfunction : obj_bytes // }
+
+  // function to build reflected crc32 table (poly 32'h04c11db7) once
+  function void init_crc32_tbl (); // {
+    bit [31:0] c;
+    if (crc32_tbl_vld)
+        return;
+    for (int n = 0; n < 256; n++)
+    begin // {
+        c = n;
+        repeat (8)
+            c = c[0] ? ((c >> 1) ^ 32'hedb88320) : (c >> 1);
+        crc32_tbl[n] = c;
+    end // }
+    crc32_tbl_vld = 1'b1;
+  endfunction : init_crc32_tbl // }
+
   // function to compute crc32
   function bit [31:0] crc32 (bit [7:0]  pkt [],
                              bit [31:0] len     = 0, 
                              bit [31:0] offset  = 0, 
                              bit        corrupt = 0); // {
+    `PROF_BEGIN
     int        corrupt_bit;
     bit [31:0] crc = 32'hffffffff;
     bit [31:0] crc32_array [256];
@@ -295,6 +323,7 @@ class pktlib_crc_chksm_class; // {
         corrupt_bit        = $urandom_range(0,31);
         crc32[corrupt_bit] = ~crc32[corrupt_bit];
     end // }
+    `PROF_END ("crc32", "crc_chksm")
 endfunction : crc32 // }
 
   // function to compute crc16
@@ -302,6 +331,7 @@ endfunction : crc32 // }
                              bit [31:0] len     = 0, 
                              bit [31:0] offset  = 0, 
                              bit        corrupt = 0); // {
+    `PROF_BEGIN
     int        corrupt_bit;
     bit [15:0] crc = 16'hffff;
     bit [7:0]  local_reg;
@@ -575,6 +605,7 @@ endfunction : crc32 // }
         corrupt_bit        = $urandom_range(0,15);
         crc16[corrupt_bit] = ~crc16[corrupt_bit];
     end // }
+    `PROF_END ("crc16", "crc_chksm")
   endfunction : crc16 // }
 
   // function to compute checksum16
@@ -584,6 +615,7 @@ endfunction : crc32 // }
                                bit        corrupt     = 0,
                                bit [15:0] corrupt_msk = 16'hffff,
                                bit [31:0] chksm       = 32'h00000000); // {
+    `PROF_BEGIN
     bit [15:0] local_reg;
     bit [31:0] local_chksm;
     // get the one's complement of orig checksum, if it is nonzero
@@ -612,14 +644,165 @@ endfunction : crc32 // }
 `ifdef DEBUG_CHKSM
     $display("%m : orig chksm 0x%x final chksm16 0x%x", chksm, chksm16);
 `endif    
+    `PROF_END ("chksm16", "crc_chksm")
   endfunction : chksm16 // }
 
+  // function to compute checksum16 directly on pkt[offset +: len], without copy
+  // odd length is implicitly padded with 8'h0, pseudo hdr sum is folded in as integer
+  function bit [15:0] chksm16_slice (const ref bit [7:0]  pkt [],
+                                     input     int        offset      = 0,
+                                     input     int        len         = 0,
+                                     input     bit        corrupt     = 0,
+                                     input     bit [15:0] corrupt_msk = 16'hffff,
+                                     input     bit [31:0] pseudo_sum  = 32'h0); // {
+    `PROF_BEGIN
+    bit [31:0] local_chksm;
+    local_chksm = pseudo_sum;
+    if ((offset + len) > pkt.size)
+        len = pkt.size - offset;
+    while (len > 1)
+    begin // {
+        local_chksm += {pkt[offset], pkt[offset+1]};
+        offset      += 2;
+        len         -= 2;
+    end // }
+    if (len > 0)
+        local_chksm += {pkt[offset], 8'h00};
+    if (corrupt)
+        chksm16_slice = (~chksm16_fold (local_chksm)) ^ corrupt_msk;
+    else
+        chksm16_slice = (~chksm16_fold (local_chksm));
+    `PROF_END ("chksm16_slice", "crc_chksm")
+  endfunction : chksm16_slice // }
+
+  // function to fold 32 bit one's complement sum into 16 bits
+  function bit [15:0] chksm16_fold (bit [31:0] sum); // {
+    while (sum >> 16)
+      sum = (sum & 16'hffff) + (sum >> 16);
+    chksm16_fold = sum;
+  endfunction : chksm16_fold // }
+
+  // function to incrementally update checksum16 (RFC 1624, Eqn. 3)
+  // HC' = ~(~HC + ~m + m'), m and m' are old and new 16 bit words
+  function bit [15:0] chksm16_update (bit [15:0] chksm,
+                                      bit [15:0] old_word,
+                                      bit [15:0] new_word); // {
+    bit [31:0] local_chksm;
+    local_chksm = (~chksm & 16'hffff) + (~old_word & 16'hffff) + new_word;
+    while (local_chksm >> 16)
+      local_chksm = (local_chksm & 16'hffff) + (local_chksm >> 16);
+    chksm16_update = ~local_chksm;
+  endfunction : chksm16_update // }
+
+  // function to compute raw crc32 register (no pre/post inversion, no byte swap)
+  // raw crc32 is linear, so crc32 of modified pkt = crc32 of orig pkt ^ raw crc32 of (orig ^ modified)
+  function bit [31:0] crc32_raw (const ref bit [7:0]  pkt [],
+                                 input     bit [31:0] len    = 0,
+                                 input     bit [31:0] offset = 0,
+                                 input     bit [31:0] crc    = 0); // {
+    init_crc32_tbl ();
+    while (len--)
+    begin // {
+        crc = (crc >> 8) ^ crc32_tbl[(crc ^ pkt[offset]) & 8'hff];
+        offset++;
+    end // }
+    crc32_raw = crc;
+  endfunction : crc32_raw // }
+
+  // function to advance raw crc32 register over len zero bytes in O(log(len)) (zlib crc32_combine)
+  function bit [31:0] crc32_zero_ext (bit [31:0] crc,
+                                      int        len); // {
+    bit [31:0] even [32];
+    bit [31:0] odd  [32];
+    bit [31:0] row;
+    if (len <= 0)
+        return crc;
+    // operator for one zero bit
+    odd[0] = 32'hedb88320;
+    row    = 1;
+    for (int n = 1; n < 32; n++)
+    begin // {
+        odd[n] = row;
+        row    = row << 1;
+    end // }
+    gf2_matrix_square (even, odd); // two zero bits
+    gf2_matrix_square (odd, even); // four zero bits
+    while (len != 0)
+    begin // {
+        gf2_matrix_square (even, odd);
+        if (len & 1)
+            crc = gf2_matrix_times (even, crc);
+        len >>= 1;
+        if (len == 0)
+            break;
+        gf2_matrix_square (odd, even);
+        if (len & 1)
+            crc = gf2_matrix_times (odd, crc);
+        len >>= 1;
+    end // }
+    crc32_zero_ext = crc;
+  endfunction : crc32_zero_ext // }
+
+  function bit [31:0] gf2_matrix_times (bit [31:0] mat [32],
+                                        bit [31:0] vec); // {
+    int i = 0;
+    gf2_matrix_times = 0;
+    while (vec != 0)
+    begin // {
+        if (vec[0])
+            gf2_matrix_times ^= mat[i];
+        vec >>= 1;
+        i++;
+    end // }
+  endfunction : gf2_matrix_times // }
+
+  function void gf2_matrix_square (ref   bit [31:0] square [32],
+                                   input bit [31:0] mat    [32]); // {
+    for (int n = 0; n < 32; n++)
+        square[n] = gf2_matrix_times (mat, mat[n]);
+  endfunction : gf2_matrix_square // }
+
+  // function to compute crc32 over pkt[offset +: len] directly, without copy. Bytes at
+  // msk_off[] (ascending, absolute) are taken as msk_val[] instead of pkt, and zero_len
+  // zero bytes are appended. Result is same as crc32 on a masked copy
+  function bit [31:0] crc32_masked (const ref bit [7:0]  pkt [],
+                                    input     bit [31:0] len,
+                                    input     bit [31:0] offset,
+                                    input     int        msk_off [$],
+                                    input     bit [7:0]  msk_val [$],
+                                    input     bit        corrupt  = 0,
+                                    input     int        zero_len = 0); // {
+    `PROF_BEGIN
+    int        corrupt_bit;
+    bit [31:0] crc = 32'hffffffff;
+    bit [31:0] pos = offset;
+    init_crc32_tbl ();
+    foreach (msk_off[ls])
+    begin // {
+        if ((msk_off[ls] < pos) | (msk_off[ls] >= offset + len))
+            continue;
+        crc = crc32_raw (pkt, msk_off[ls] - pos, pos, crc);
+        crc = (crc >> 8) ^ crc32_tbl[(crc ^ msk_val[ls]) & 8'hff];
+        pos = msk_off[ls] + 1;
+    end // }
+    crc = crc32_raw (pkt, offset + len - pos, pos, crc);
+    crc = crc32_zero_ext (crc, zero_len);
+    crc32_masked = {~crc [7:0], ~crc [15:8], ~crc [23:16], ~crc [31:24]};
+    if (corrupt)
+    begin // {
+        corrupt_bit               = $urandom_range(0,31);
+        crc32_masked[corrupt_bit] = ~crc32_masked[corrupt_bit];
+    end // }
+    `PROF_END ("crc32_masked", "crc_chksm")
+  endfunction : crc32_masked // }
+
   // function to compute checksum8
   function bit [7:0] chksm8 (bit [7:0]  pkt [],
                              bit [31:0] len         = 0, 
                              bit [31:0] offset      = 0, 
                              bit        corrupt     = 0, 
                              bit [07:0] corrupt_msk = 8'hff); // {
+    `PROF_BEGIN
     bit [15:0] chksm = 16'h0000;
     bit [07:0] local_reg;
     while (len-- )
@@ -633,6 +816,7 @@ endfunction : crc32 // }
       chksm8 = (~chksm) ^ corrupt_msk;
     else
       chksm8 = (~chksm);
+    `PROF_END ("chksm8", "crc_chksm")
   endfunction : chksm8 // }
 
   function bit [31:0] reflect (bit [31:0] v, int b); // {
@@ -15,13 +15,31 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //  Common display class for all the hdrs
 // ----------------------------------------------------------------------
 
-class pktlib_display_class; // {
+class pktlib_display_class extends pktlib_object_class; // {
 
   // ~~~~~~~~~~ Class variables ~~~~~~~~~~
         string       cls_name;
         int          err;
         int          index;
         bit [7:0]    null_a [];
+        int          fld_off [string];   // bit offset of each field (FIELD_MAP mode)
+        int          fld_sz  [string];   // bit size of each field (FIELD_MAP mode)
+        string       fld_q   [$];        // fields in pkt order (FIELD_MAP mode)
+        string       fld_hdr [$];        // hdr name of each fld_q entry
+
+  // ~~~~~~~~~~ Global display policy, see set_dsp_policy ~~~~~~~~~~
+  static int          dsp_policy  = DSP_ALL;
+  static int          dsp_n       = 1;
+  static bit          dsp_hid [int];      // if not empty, only pkts with one of these hids
+  static int          dsp_pkt_cnt = 0;    // pkts packed/unpacked so far, numbers pkts for policy
+  static string       hex_str [256];      // "%h " of each byte, used to build hexdump rows
+
+  // ~~~~~~~~~~ Flight recorder, see set_rec_depth ~~~~~~~~~~
+  static int          rec_depth   = 0;    // pkts kept per stream (pnum), 0 : off
+  static bit          rec_busy    = 1'b0; // set while pktlib unpacks for its own use
+  static pktlib_rec_t rec_buf [int][];    // ring of last rec_depth pkts of each stream
+  static int          rec_wr  [int];      // pkts recorded so far for each stream
+  static int          trc_hdl     = -1;   // binary pkt trace handle (PKTLIB_DPI_TRACE), -1 : off
 
   function new (string cls_name = ""); // {
     this.cls_name = cls_name;
@@ -30,6 +48,62 @@ class pktlib_display_class; // {
     this.null_a   = new [0];
   endfunction : new // }
 
+  function string obj_type (); // {
+    return "pktlib_display_class";
+  endfunction : obj_type // }
+
+  function int obj_bytes (); // {
+    return 128;
+  endfunction : obj_bytes // }
+
+  // This function sets global display policy for all pktlibs. Miscompares
+  // are displayed with every policy except DSP_NONE
+  static function void set_dsp_policy (int policy = DSP_ALL,
+                                       int n      = 1,
+                                       int hid_q [$] = {}); // {
+    dsp_policy = policy;
+    dsp_n      = (n > 0) ? n : 1;
+    dsp_hid.delete ();
+    foreach (hid_q[ls])
+        dsp_hid [hid_q[ls]] = 1'b1;
+  endfunction : set_dsp_policy // }
+
+  // This function returns 1 if pkt number pkt_no is to be displayed as per
+  // policy, err is set for a miscompare
+  static function bit dsp_pkt (int pkt_no,
+                               bit err = 1'b0); // {
+    if (err & (dsp_policy != DSP_NONE))
+        return 1'b1;
+    case (dsp_policy) // {
+        DSP_EVERY_NTH : return ((pkt_no % dsp_n) == 0);
+        DSP_FIRST_N   : return (pkt_no <= dsp_n);
+        DSP_ON_ERR    : return 1'b0;
+        DSP_NONE      : return 1'b0;
+        default       : return 1'b1;
+    endcase // }
+  endfunction : dsp_pkt // }
+
+  // This function turns flight recorder on (depth pkts per stream) or off
+  // (depth 0). pack_hdr/unpack_hdr keep raw pkts, nothing is formatted till
+  // pktlib_main_class::dump_history
+  static function void set_rec_depth (int depth = 16); // {
+    rec_depth = (depth > 0) ? depth : 0;
+    rec_buf.delete ();
+    rec_wr.delete ();
+  endfunction : set_rec_depth // }
+
+  // This function fills hex_str once
+  static function void init_hex_str (); // {
+    bit [7:0] b;
+    if (hex_str[0] != "")
+        return;
+    for (int i = 0; i < 256; i++)
+    begin // {
+        b = i;
+        $sformat (hex_str[i], "%h ", b);
+    end // }
+  endfunction : init_hex_str // }
+
   // This task displays the feild of individual hdr
   task display_fld (int               mode        = DISPLAY, // display or compare
                     string            hname,                 // string literals
@@ -42,8 +116,28 @@ class pktlib_display_class; // {
                     bit [7:0]         flarray  [] = null_a,
                     bit [7:0]         flarray2 [] = null_a,
                     string            flcomment   = "NO");   // comments if field type is STRING {
-    $sformat (hname, "%16s", hname);
-    $sformat (flname,"%32s",flname);
+    string line;
+    // FIELD_MAP only records where each field sits in the pkt, nothing is displayed
+    if (mode == FIELD_MAP)
+    begin // {
+        if (fltype == BIT_VEC)
+        begin // {
+            fld_off [{hname, ".", flname}] = index;
+            fld_sz  [{hname, ".", flname}] = flsz;
+            fld_q.push_back   ({hname, ".", flname});
+            fld_hdr.push_back (hname);
+            index += flsz;
+        end // }
+        if (fltype == ARRAY)
+        begin // {
+            fld_off [{hname, ".", flname}] = index;
+            fld_sz  [{hname, ".", flname}] = flarray.size*8;
+            fld_q.push_back   ({hname, ".", flname});
+            fld_hdr.push_back (hname);
+            index += flarray.size*8;
+        end // }
+        return;
+    end // }
     if ((mode == NO_DISPLAY) |(mode == COMPARE_NO_DISPLAY))
     begin // {
         if ((fltype == BIT_VEC) | (fltype == BIT_VEC_NH))
@@ -56,35 +150,38 @@ class pktlib_display_class; // {
     end // }
     else 
     begin // {
+        // names are padded only when displayed, each field is one $display
+        $sformat (hname, "%16s", hname);
+        $sformat (flname,"%32s",flname);
         if (fltype == STRING)
             $display ("%0s%s : %s", cls_name, hname, flcomment);
         if ((fltype == BIT_VEC) | (fltype == BIT_VEC_NH))
         begin // { 
             if (fltype == BIT_VEC)
-                $write("%0s%s : [%4d : %4d] : %3d : %s : ", cls_name, hname, index, index+flsz-1, index/8, flname);
+                $sformat (line, "%0s%s : [%4d : %4d] : %3d : %s : ", cls_name, hname, index, index+flsz-1, index/8, flname);
             else
-                $write("%0s%s :                       %s : ", cls_name, hname, flname);
+                $sformat (line, "%0s%s :                       %s : ", cls_name, hname, flname);
             case (flval) // {
-                HEX     : $write ("%0d'h%0x ", flsz, flvec);
-                BIN     : $write ("%0d'b%0b ", flsz, flvec);
-                DEC     : $write ("%0d'd%0d ", flsz, flvec);
-                DEF     : $write ("%0d ",      flvec);
-                default : $write ("%0d ",      flvec);
+                HEX     : $sformat (line, "%0s%0d'h%0x ", line, flsz, flvec);
+                BIN     : $sformat (line, "%0s%0d'b%0b ", line, flsz, flvec);
+                DEC     : $sformat (line, "%0s%0d'd%0d ", line, flsz, flvec);
+                DEF     : $sformat (line, "%0s%0d ",      line, flvec);
+                default : $sformat (line, "%0s%0d ",      line, flvec);
             endcase // }
             if (((mode === COMPARE) | (mode === COMPARE_FULL)) & (flvec != flvec2))
             begin // {
                 err++;
                 case (flval) // {
-                HEX     : $write ("!= %0d'h%0x (ERROR) ", flsz, flvec2);
-                BIN     : $write ("!= %0d'b%0b (ERROR) ", flsz, flvec2);
-                DEC     : $write ("!= %0d'd%0d (ERROR) ", flsz, flvec2);
-                DEF     : $write ("!= %0d (ERROR) ",      flvec2);
-                default : $write ("!= %0d (ERROR) ",      flvec2);
+                HEX     : $sformat (line, "%0s!= %0d'h%0x (ERROR) ", line, flsz, flvec2);
+                BIN     : $sformat (line, "%0s!= %0d'b%0b (ERROR) ", line, flsz, flvec2);
+                DEC     : $sformat (line, "%0s!= %0d'd%0d (ERROR) ", line, flsz, flvec2);
+                DEF     : $sformat (line, "%0s!= %0d (ERROR) ",      line, flvec2);
+                default : $sformat (line, "%0s!= %0d (ERROR) ",      line, flvec2);
             endcase // }
             end // }
             if (flcomment != "NO")
-                $write   ("(%s)", flcomment);
-            $write("\n");
+                line = {line, "(", flcomment, ")"};
+            $display ("%0s", line);
         end // }
         if ((fltype == ARRAY) | (fltype == ARRAY_NH))
         begin // {
@@ -93,16 +190,16 @@ class pktlib_display_class; // {
              else
              begin // {
                  if (fltype == ARRAY)
-                     $write("%0s%s :               : %3d : %s : ", cls_name, hname, index/8, flname);
+                     $sformat (line, "%0s%s :               : %3d : %s : ", cls_name, hname, index/8, flname);
                  else
-                     $write("%0s%s :                       %s : ", cls_name, hname, flname);
+                     $sformat (line, "%0s%s :                       %s : ", cls_name, hname, flname);
                  if (flarray.size != 0)
                  begin // {
-                     $write ("(Total Len  = %0d)\n", flarray.size());
+                     $display ("%0s(Total Len  = %0d)", line, flarray.size());
                      display_array8 (flarray, hname, "NO", 0, 0);
                  end // }
                  else
-                     $write ("(EMPTY)\n");
+                     $display ("%0s(EMPTY)", line);
              end // }
         end // }
     end // }
@@ -118,38 +215,37 @@ class pktlib_display_class; // {
                        string           usr_comment = "NO",
                        int              mode        = 0,
                        int              n_atend     = 1); // {
+    string line;
+    init_hex_str ();
     $sformat (hname, "%16s", hname);
     if (usr_comment != "NO")
-        $write ("%0s%s : %s\n",cls_name, hname, usr_comment);  
-    for (int i = 0; i < 16 ; i++)
+        $display ("%0s%s : %s",cls_name, hname, usr_comment);  
+    // every row is built in line and written with one $display
+    $sformat (line, "%0s%s :       %2d ", cls_name, hname, 0);
+    for (int i = 1; i < 16 ; i++)
     begin // {
-        if (i % 16 == 0)
-            $write ("%0s%s :       %2d ", cls_name, hname, i);
-        else if (i % 16 == 7)
-            $write ("%3d |", i);
-        else if (i % 16 == 15)
-            $write ("%3d\n", i);
+        if (i % 16 == 7)
+            $sformat (line, "%0s%3d |", line, i);
         else
-            $write ("%3d", i);
+            $sformat (line, "%0s%3d", line, i);
     end // }
-    $write ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~\n", cls_name, hname);
+    $display ("%0s", line);
+    $display ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~", cls_name, hname);
     for (int i = 0; i < data.size(); i++)
     begin
         if (i % 16 == 0)
-            $write ("%0s%s : %4d : ", cls_name, hname, i);
-        $write ("%x ", data[i]);
+            $sformat (line, "%0s%s : %4d : ", cls_name, hname, i);
+        line = {line, hex_str[data[i]]};
         if (i % 16 == 7)
-            $write ("| ");
-        if (i % 16 == 15)
-            $write ("\n");
+            line = {line, "| "};
+        if ((i % 16 == 15) | (i == data.size() - 1))
+            $display ("%0s", line);
     end
-    if (data.size() % 16 !== 0)
-        $write ("\n");
-    $write ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~\n", cls_name, hname);
+    $display ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~", cls_name, hname);
     if (mode)
-        $write ("%s%s : (Total Len  = %0d)\n", cls_name, hname, data.size());
+        $display ("%s%s : (Total Len  = %0d)", cls_name, hname, data.size());
     repeat (n_atend)
-       $write ("\n");
+       $display ("");
   endtask : display_array8 // }
 
  task compare_array8 (       bit [7:0]        rcv [],
@@ -166,6 +262,8 @@ class pktlib_display_class; // {
     int i, off, err;
     bit always_display;
     bit [7:0] tmp;
+    string line;
+    init_hex_str ();
     $sformat (hname, "%16s", hname);
     $sformat (flname,"%32s",flname);
     err = 0;
@@ -194,9 +292,9 @@ class pktlib_display_class; // {
       if (cmp_type == "pkt_lib")
       begin // {
           if (err !== 0)
-              $write ("%0s%s : %s : Mismatch (ERROR) :-( Length Rcv => %0d Exp => %0d\n",cls_name, hname, flname, rcv_len, exp_len);  
+              $display ("%0s%s : %s : Mismatch (ERROR) :-( Length Rcv => %0d Exp => %0d",cls_name, hname, flname, rcv_len, exp_len);  
           else
-              $write ("%0s%s : %s : Matched :-) Length Rcv => %0d Exp => %0d\n",cls_name, hname, flname, rcv_len, exp_len);  
+              $display ("%0s%s : %s : Matched :-) Length Rcv => %0d Exp => %0d",cls_name, hname, flname, rcv_len, exp_len);  
       end // }
       else
       begin // {
@@ -210,57 +308,47 @@ class pktlib_display_class; // {
       off = 0;
       if (err | always_display | (nochkcnt > 0))
       begin // {
-        $write ("%0s%s :        ~~~~~~~~~ RCV ~~~~~~~~~~|~~~~~~~~~ EXP ~~~~~~~~~~\n", cls_name, hname);
-        for (i = 0; i < 16 ; i++)
+        $display ("%0s%s :        ~~~~~~~~~ RCV ~~~~~~~~~~|~~~~~~~~~ EXP ~~~~~~~~~~", cls_name, hname);
+        $sformat (line, "%0s%s :       %2d ", cls_name, hname, 0);
+        for (i = 1; i < 16 ; i++)
         begin // {
-            if (i % 16 == 0)
-                $write ("%0s%s :       %2d ", cls_name, hname, i%8);
-            else if (i % 16 == 7)
-                $write ("%3d |", i%8);
-            else if (i % 16 == 15)
-                $write ("%3d\n", i%8);
+            if (i % 16 == 7)
+                $sformat (line, "%0s%3d |", line, i%8);
             else
-                $write ("%3d", i%8);
+                $sformat (line, "%0s%3d", line, i%8);
         end // }
-        $write ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~\n", cls_name, hname);
+        $display ("%0s", line);
+        $display ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~|~~~~~~~~~~~~~~~~~~~~~~~~", cls_name, hname);
+        // every row is built in line and written with one $display
         while (off < cmp_len)
         begin // {
+           $sformat (line, "%0s%s : %4d : ", cls_name, hname, off);
            for (i = 0; i < 8; i++)
            begin // {
                if ((off + i) < rcv_len)
-               begin // {
-                   if (i == 0)
-                       $write ("%0s%s : %4d : %h ", cls_name, hname, off, rcv[off + i]);
-                   else
-                       $write ("%h ", rcv[off + i]);
-               end // }
+                   line = {line, hex_str[rcv[off + i]]};
                else if ((off + i) < cmp_len)
-               begin // {
-                   if (i == 0)
-                       $write ("%0s%s : %4d : ?? ", cls_name, hname, off);
-                   else
-                       $write ("?? ");
-               end // }
+                   line = {line, "?? "};
                else
-                   $write ("   ");
+                   line = {line, "   "};
            end // }
-           $write ("| ");
+           line = {line, "| "};
            for (i = 0; i < 8; i++)
            begin // {
                if ((off + i) < exp_len)
                begin // {
                    tmp = exp[off + i];
                    if ((off + i) >= rcv_len)
-                       $write ("%h ", tmp[7:0]);
+                       line = {line, hex_str[tmp]};
                    else if (tmp == rcv[off + i])
-                       $write (".. ");
+                       line = {line, ".. "};
                    else
-                       $write ("%h ", tmp[7:0]);
+                       line = {line, hex_str[tmp]};
                end // }
                else if ((off + i) < cmp_len)
-                   $write ("?? ");
+                   line = {line, "?? "};
            end // }
-           $write ("\n");
+           $display ("%0s", line);
            off = off + 8;
         end // }
       end // }
@@ -275,35 +363,29 @@ class pktlib_display_class; // {
                         string           usr_comment = "NO",
                         int              mode        = 0,
                         int              n_atend     = 1); // {
+    string line;
     $sformat (hname, "%16s", hname);
     if (usr_comment != "NO")
-        $write ("%0s%s : %s\n",cls_name, hname, usr_comment);
-    for (int i = 0; i < 8 ; i++)
-    begin // {
-        if (i % 8 == 0)
-            $write ("%0s%s :       %2d ", cls_name, hname, i);
-        else if (i % 8 == 7)
-            $write ("%5d\n", i);
-        else
-            $write ("%5d", i);
-    end // }
-    $write ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n", cls_name, hname);
+        $display ("%0s%s : %s",cls_name, hname, usr_comment);
+    $sformat (line, "%0s%s :       %2d ", cls_name, hname, 0);
+    for (int i = 1; i < 8 ; i++)
+        $sformat (line, "%0s%5d", line, i);
+    $display ("%0s", line);
+    $display ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~", cls_name, hname);
     for (int i = 0; i < data.size(); i++)
     begin
         if (i % 8 == 0)
-            $write ("%0s%s : %4d : ", cls_name, hname, i);
-        $write ("%x ", data[i]);
-        if (i % 8 == 7)
-            $write ("\n");
+            $sformat (line, "%0s%s : %4d : ", cls_name, hname, i);
+        $sformat (line, "%0s%x ", line, data[i]);
+        if ((i % 8 == 7) | (i == data.size() - 1))
+            $display ("%0s", line);
     end
-    if (data.size() % 8 !== 0)
-        $write ("\n");
-    $write ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n", cls_name, hname);
+    $display ("%0s%s :        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~", cls_name, hname);
    
     if (mode)
-        $write ("%s%s : (Total Len  = %0d)\n", cls_name, hname, data.size());
+        $display ("%s%s : (Total Len  = %0d)", cls_name, hname, data.size());
     repeat (n_atend)
-       $write ("\n");
+       $display ("");
   endtask : display_array16 // }
 
 endclass : pktlib_display_class // }
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+//  class to vary one field of pkt template (used by nxt_tmpl_pkt)
+// ----------------------------------------------------------------------
+
+class pktlib_fld_var_class extends pktlib_object_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  hdr_class          hdr;
+  string             field;
+  int                var_type;
+  bit [`VEC_SZ-1:0]  cur_val;
+  bit [`VEC_SZ-1:0]  step;
+  bit [`VEC_SZ-1:0]  min_val;
+  bit [`VEC_SZ-1:0]  max_val;
+  bit [`VEC_SZ-1:0]  val_list [$];
+  int                list_idx = 0;
+
+  function new (hdr_class         hdr,
+                string            field,
+                int               var_type,
+                bit [`VEC_SZ-1:0] start_val,
+                bit [`VEC_SZ-1:0] step,
+                bit [`VEC_SZ-1:0] min_val,
+                bit [`VEC_SZ-1:0] max_val,
+                bit [`VEC_SZ-1:0] val_list [$]); // {
+    this.hdr      = hdr;
+    this.field    = field;
+    this.var_type = var_type;
+    this.cur_val  = start_val;
+    this.step     = step;
+    this.min_val  = min_val;
+    this.max_val  = max_val;
+    this.val_list = val_list;
+  endfunction : new // }
+
+  function string obj_type (); // {
+    return "pktlib_fld_var_class";
+  endfunction : obj_type // }
+
+  function int obj_bytes (); // {
+    return 128;
+  endfunction : obj_bytes // }
+
+  // This function returns value of field for next pkt
+  function bit [`VEC_SZ-1:0] nxt_val (); // {
+    bit [`VEC_SZ-1:0] rng;
+    case (var_type) // {
+        FLD_INCR :
+        begin // {
+            nxt_val = cur_val;
+            if ((max_val - cur_val) < step)
+                cur_val = min_val;
+            else
+                cur_val += step;
+        end // }
+        FLD_DECR :
+        begin // {
+            nxt_val = cur_val;
+            if ((cur_val - min_val) < step)
+                cur_val = max_val;
+            else
+                cur_val -= step;
+        end // }
+        FLD_RND  :
+        begin // {
+            for (int i = 0; i < `VEC_SZ/32; i++)
+                nxt_val [i*32 +: 32] = $urandom;
+            rng = max_val - min_val + 1;
+            if (rng != 0)
+                nxt_val = min_val + (nxt_val % rng);
+        end // }
+        FLD_LIST :
+        begin // {
+            if (val_list.size == 0)
+                return cur_val;
+            nxt_val  = val_list [list_idx];
+            list_idx = (list_idx + 1) % val_list.size;
+        end // }
+    endcase // }
+  endfunction : nxt_val // }
+
+endclass : pktlib_fld_var_class // }
@@ -0,0 +1,49 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+//  class to hold hdr list of a pkt, shared by all hdrs of the list and
+//  pktlib (one copy instead of one all_hdr queue per hdr). Also caches
+//  prefix sums of trl_len (used by unpack)
+// ----------------------------------------------------------------------
+
+class pktlib_hdr_stack_class extends pktlib_object_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  rand hdr_class  all_hdr [$];   // all the hdrs of list, in order
+       bit [15:0] trl_sum [$];   // trl_sum[i] = sum of trl_len of all_hdr[0 .. i-1]
+       int        ref_cnt = 1;   // number of pktlib sharing this stack (copy on write)
+
+  function new (); // {
+  endfunction : new // }
+
+  function string obj_type (); // {
+    return "pktlib_hdr_stack_class";
+  endfunction : obj_type // }
+
+  // function to drop cached trl_len sums, needed when any trl_len changes
+  function void clr_trl_sum (); // {
+    trl_sum = {0};
+  endfunction : clr_trl_sum // }
+
+  // function to get sum of trl_len of hdrs before c_id, extends cache as needed
+  function bit [15:0] get_trl_sum (int c_id); // {
+    if (trl_sum.size == 0)
+        trl_sum.push_back (0);
+    while ((trl_sum.size <= c_id) & (trl_sum.size <= all_hdr.size))
+        trl_sum.push_back (trl_sum[$] + all_hdr[trl_sum.size-1].trl_len);
+    return trl_sum[(c_id < trl_sum.size) ? c_id : trl_sum.size-1];
+  endfunction : get_trl_sum // }
+
+endclass : pktlib_hdr_stack_class // }
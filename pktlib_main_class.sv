@@ -26,11 +26,28 @@ class pktlib_main_class extends pktlib_object_class; // {
          int                  inst_db [TOTAL_HID]; // instance number database needed for unpack
   rand   hdr_class            first_hdr;
          hdr_class            hdr_q   [$];
+         pktlib_hdr_stack_class hdr_stk = new ();   // hdr list shared by all the cfg hdrs
          bit [7:0]            org_pkt [];            // original packet after build was done
          bit [7:0]            pkt     [];            // pkt after build was done
+         bit [7:0]            view_buf[];            // pkt reshaped by a data_view unpack, data/pad views point in to it
+         bit                  view_in_pkt   = 1'b0;  // data/pad views point in to pkt instead of view_buf
          bit                  pkt_modified  = 1'b0;  // indicates wether pkt got modified in post_pack
          string               cfg_hdr_list;
+         bit [63:0]           hdr_sig       = 0;     // hash of hid/inst_no of all_hdr & pkt_format, see get_hdr_sig
          int                  pkt_format    = IEEE802;
+         pktlib_display_class hfld;                  // field map of pkt, used by patch_field
+         bit                  fld_map_vld   = 1'b0;  // indicates hfld is in sync with pkt
+         pktlib_fld_var_class fld_var_q     [$];     // fields varied by nxt_tmpl_pkt
+         bit                  use_solver    = 1'b0;  // fast_randomize uses solver, set if user constraints are present
+         int                  dsp_pkt_no    = 0;     // pkt number for global display policy
+         bit                  data_view     = 1'b0;  // unpack_hdr leaves data/pad as views in pkt, see fetch_views
+  `ifdef PKTLIB_DPI_PROF
+         int                  prof_rand_d   = -1;    // depth of open randomize stage (pktlib_prof_class)
+  `endif
+  `ifdef PKTLIB_DPI_TRACE
+         int                  corpus_hdl    = -1;    // pkt corpus handle, see corpus_open
+         bit                  corpus_rd     = 1'b0;  // 1 : replaying corpus, 0 : writing it
+  `endif
 
   // ~~~~~~~~~~ Contol variables for pkt driver ~~~~~~~~~~
          int                  pid          = 0;           // Packet Id
@@ -59,6 +76,40 @@ class pktlib_main_class extends pktlib_object_class; // {
   function new (); // {
   endfunction : new // }
 
+  function string obj_type (); // {
+    return "pktlib_main_class";
+  endfunction : obj_type // }
+
+  // hdr_db/inst_db handles, hdrs are counted by their own
+  function int obj_bytes (); // {
+    return (TOTAL_HID * (`MAX_NUM_INSTS + 2) * 8) + 512;
+  endfunction : obj_bytes // }
+
+  // This function displays objects newed per class (estimated bytes, sorted
+  // by bytes, top classes only if top > 0) and most objects newed for one
+  // pkt. Objects newed by new pktlib are counted for its first pkt
+  static function void report_alloc (int top = 0); // {
+    string  name_q [$];
+    longint tot_cnt   = 0;
+    longint tot_bytes = 0;
+    foreach (acct_cnt[name])
+    begin // {
+        name_q.push_back (name);
+        tot_cnt   += acct_cnt   [name];
+        tot_bytes += acct_bytes [name];
+    end // }
+    name_q.rsort (n) with (acct_bytes[n]);
+    $display ("%0t : INFO    : ALLOC     : %24s %12s %14s", $time, "class", "newed", "est_bytes");
+    foreach (name_q[i])
+    begin // {
+        if ((top > 0) & (i >= top))
+            break;
+        $display ("%0t : INFO    : ALLOC     : %24s %12d %14d", $time, name_q[i], acct_cnt[name_q[i]], acct_bytes[name_q[i]]);
+    end // }
+    $display ("%0t : INFO    : ALLOC     : Total %0d objects, %0d bytes for %0d pkts, high water mark per pkt %0d objects, %0d bytes",
+              $time, tot_cnt, tot_bytes, acct_num_pkt, acct_hwm_cnt, acct_hwm_bytes);
+  endfunction : report_alloc // }
+
   // This task configures and links all the hdrs used for the particular pkt
   // For E.g. -> cfg_hdr ({eth[0], dot1q[0], data[0]});
   function void cfg_hdr (hdr_class hdr [$]  = {},
@@ -82,20 +133,67 @@ class pktlib_main_class extends pktlib_object_class; // {
        DPHY_HID : pkt_format = MIPI_CSI2_DPHY;  
        default  : pkt_format = IEEE802;  
     endcase // }
+    // copy on write, if stack is shared with a copied pktlib
+    if (hdr_stk.ref_cnt > 1)
+    begin // {
+        hdr_stk.ref_cnt--;
+        hdr_stk = new ();
+    end // }
+    hdr_stk.all_hdr = hdr_q;
+    hdr_stk.clr_trl_sum ();
+    hdr_sig = 64'hcbf29ce484222325 ^ pkt_format;
     foreach (hdr_q[cfg_ls])
     begin // {
+        hdr_sig                   = hdr_sig_step (hdr_sig, hdr_q[cfg_ls]);
         hdr_q[cfg_ls].prv_hdr     = hdr_q[cfg_ls-1];
         hdr_q[cfg_ls].nxt_hdr     = hdr_q[cfg_ls+1];
-        hdr_q[cfg_ls].all_hdr     = hdr_q;
+        hdr_q[cfg_ls].hdr_stk     = hdr_stk;
         hdr_q[cfg_ls].psnt        = 1'b1;
         hdr_q[cfg_ls].cfg_id      = cfg_ls;
         hdr_q[cfg_ls].pkt_format  = pkt_format;
     end // }
-    first_hdr = hdr_q[0];
+    first_hdr   = hdr_q[0];
+    fld_map_vld = 1'b0;
     if (clr_hdrq)
         hdr_q = {};
   endfunction : cfg_hdr // }
 
+  // This function returns hdr stack signature, same for pkts with same
+  // hdrs (hid, inst_no) in same order and same pkt_format. Kept up to date
+  // by cfg_hdr (add_hdr, ins_hdr, rmv_hdr) and SMART_UNPACK, usable as key
+  // for per shape caches/coverage
+  function bit [63:0] get_hdr_sig (); // {
+    return hdr_sig;
+  endfunction : get_hdr_sig // }
+
+  // This function copies data/pad views left by a data_view unpack_hdr in
+  // to data_class::data/toh_class::pad_data. Needed before reading those
+  // arrays directly; pack, display and cpy do it on their own. Views are
+  // valid till the next unpack_hdr of this pktlib
+  function void fetch_views (); // {
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+        first_hdr.hdr_stk.all_hdr[ls].fetch_view ();
+    view_in_pkt = 1'b0;
+  endfunction : fetch_views // }
+
+  // This function seeds payload PRNG of all cfg hdrs, same seed gives same
+  // data/pad bytes. The seed is kept over randomize. cfg_hdr must be done before
+  function void seed_prng (bit [63:0] seed); // {
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+        first_hdr.hdr_stk.all_hdr[ls].harray.seed_prng (seed + ls);
+  endfunction : seed_prng // }
+
+  // This function returns byte off of the pkt data/pad views point in to
+  function bit [7:0] view_byte (int off); // {
+    return (view_in_pkt ? pkt[off] : view_buf[off]);
+  endfunction : view_byte // }
+
+  // This function folds one hdr in to hdr stack signature (FNV-1a 64)
+  static function bit [63:0] hdr_sig_step (bit [63:0] sig,
+                                           hdr_class  hdr); // {
+    return ((sig ^ {hdr.hid[15:0], hdr.inst_no[15:0]}) * 64'h100000001b3);
+  endfunction : hdr_sig_step // }
+
   //  This task adds hdr/hdrs to hdr_q statically until last_hdr = 1
   task add_hdr (hdr_class hdr [$]  = {},
                 bit       last_hdr = 1'b0); // { 
@@ -111,7 +209,7 @@ class pktlib_main_class extends pktlib_object_class; // {
                 int       after_inst = 0); // {
     hdr_class hdr[$];
     hdr_q = {};
-    hdr   = first_hdr.all_hdr;
+    hdr   = first_hdr.hdr_stk.all_hdr;
     foreach (hdr[hdr_ls])
     begin // {
         if ((hdr[hdr_ls].hid == after_hid) & (hdr[hdr_ls].inst_no == after_inst))
@@ -125,7 +223,7 @@ class pktlib_main_class extends pktlib_object_class; // {
                 int inst_rm = 0); // {
     hdr_class hdr[$];
     hdr_q = {};
-    hdr   = first_hdr.all_hdr;
+    hdr   = first_hdr.hdr_stk.all_hdr;
     foreach (hdr[hdr_ls])
     begin // {
         if ((hdr[hdr_ls].hid == hid_rm) & (hdr[hdr_ls].inst_no == inst_rm))
@@ -135,18 +233,131 @@ class pktlib_main_class extends pktlib_object_class; // {
   endtask : rmv_hdr // }
 
   function void pre_randomize (); // {
+    `ifdef PKTLIB_DPI_PROF
+    if (prof_rand_d < 0)
+        prof_rand_d = pktlib_prof_class::push ();
+    `endif
   endfunction : pre_randomize // }
 
   function void post_randomize (); // {
+    `ifdef PKTLIB_DPI_PROF
+    pktlib_prof_class::pop ("randomize", "pktlib", prof_rand_d);
+    prof_rand_d = -1;
+    `endif
   endfunction : post_randomize // }
 
+  // This function randomizes all the configured hdrs without the solver.
+  // Each hdr fills its own fields, data_len takes what is left of plen and
+  // lengths/offsets are computed bottom up. Falls back to randomize () if
+  // use_solver is set or any hdr has no fast path.
+  // For E.g. -> cfg_hdr ({eth[0], ipv4[0], udp[0], data[0]}); fast_randomize ();
+  function bit fast_randomize (); // {
+    toh_class  lcl_toh;
+    data_class lcl_data;
+    hdr_class  h;
+    int        fixed_len, lo, hi, data_len, rem;
+    `ifdef PKTLIB_DPI_PROF
+    if (prof_rand_d < 0)
+        prof_rand_d = pktlib_prof_class::push ();
+    `endif
+    if (use_solver)
+        return this.randomize ();
+    $cast (lcl_toh, first_hdr);
+    lcl_data  = null;
+    fixed_len = 0;
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+    begin // {
+        h = first_hdr.hdr_stk.all_hdr[ls];
+        if (h.use_solver || ~h.fast_randomize ())
+            return this.randomize ();
+        if (h.hid == DATA_HID)
+        begin // {
+            // only one data hdr can absorb the plen
+            if (lcl_data != null)
+                return this.randomize ();
+            $cast (lcl_data, h);
+        end // }
+        else
+            fixed_len += h.hdr_len + h.trl_len;
+    end // }
+    fixed_len += lcl_toh.pad_len;
+    // pick data_len so plen is in [min_plen : max_plen] with legal residue
+    lo = int'(lcl_toh.min_plen) - fixed_len;
+    hi = int'(lcl_toh.max_plen) - fixed_len;
+    if (lo < 0)
+        lo = 0;
+    if (hi > `MAX_PLEN)
+        hi = `MAX_PLEN;
+    if (lcl_data == null)
+        hi = 0;
+    if (lo > hi)
+        return this.randomize ();
+    data_len = $urandom_range (hi, lo);
+    if (lcl_toh.plen_multiple_of > 1)
+    begin // {
+        rem       = (fixed_len + data_len) % lcl_toh.plen_multiple_of;
+        data_len += (lcl_toh.plen_residue + lcl_toh.plen_multiple_of - rem) % lcl_toh.plen_multiple_of;
+        if (data_len > hi)
+            data_len -= lcl_toh.plen_multiple_of;
+        if (data_len < lo)
+            return this.randomize ();
+    end // }
+    if (lcl_data != null)
+    begin // {
+        lcl_data.data_len = data_len;
+        lcl_data.hdr_len  = data_len;
+        lcl_data.trl_len  = 0;
+    end // }
+    // total_hdr_len bottom up, start_off top down
+    for (int i = first_hdr.hdr_stk.all_hdr.size - 1; i >= 0; i--)
+    begin // {
+        h = first_hdr.hdr_stk.all_hdr[i];
+        case (h.hid) // {
+            EOH_HID : h.total_hdr_len = 0;
+            TOP_HID : h.total_hdr_len = h.nxt_hdr.total_hdr_len;
+            default : h.total_hdr_len = h.hdr_len + h.trl_len + h.nxt_hdr.total_hdr_len;
+        endcase // }
+    end // }
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+    begin // {
+        h = first_hdr.hdr_stk.all_hdr[ls];
+        if ((h.hid == TOP_HID) | (h.hid == EOH_HID))
+            h.start_off = 0;
+        else
+            h.start_off = h.prv_hdr.start_off + h.prv_hdr.hdr_len;
+    end // }
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+        first_hdr.hdr_stk.all_hdr[ls].fast_post_len ();
+    post_randomize ();
+    return 1'b1;
+  endfunction : fast_randomize // }
+
   // This task packs all the fields of each configured hdr into byte array of pkt
   // this task is called after randomization
   task pack_hdr (ref    bit [7:0] ppkt []); // {
+    `PROF_BEGIN
     int index;
     index = 0;
-    this.first_hdr.pack_hdr (ppkt, index);
-    pkt   = new [ppkt.size] (ppkt);
+    // views in to pkt are fetched before pkt is rebuilt
+    if (view_in_pkt)
+        fetch_views ();
+    // pack straight into this.pkt (sized once by toh). ppkt = pkt is the one
+    // copy left, pkt is kept for patch_field, diff_hdr and recorder
+    this.first_hdr.pack_hdr (pkt, index);
+    ppkt        = pkt;
+    fld_map_vld = 1'b0;
+    // pkts unpacked by pktlib for its own use (compare, history) are not numbered
+    if (~pktlib_display_class::rec_busy)
+        dsp_pkt_no = ++pktlib_display_class::dsp_pkt_cnt;
+    if ((pktlib_display_class::rec_depth > 0) & ~pktlib_display_class::rec_busy)
+        rec_pkt (1'b0);
+    `ifdef PKTLIB_DPI_TRACE
+    if ((pktlib_display_class::trc_hdl >= 0) & ~pktlib_display_class::rec_busy)
+        trace_pkt (pkt, TRC_PACK);
+    `endif
+    if (acct_en)
+        acct_pkt ();
+    `PROF_END ("pack_hdr", "pktlib")
   endtask : pack_hdr // }
 
   // This task unpacks packs all the fields of each configured hdr
@@ -154,10 +365,9 @@ class pktlib_main_class extends pktlib_object_class; // {
                    input int       mode     = DUMB_UNPACK,
                    input hdr_class hdr [$]  = {},
                    input int       p_format = IEEE802); // {
-    bit [7:0] copy_pkt [];
+    `PROF_BEGIN
     int       index;
     index    = 0;
-    copy_pkt = ppkt; 
     // clear instance database
     foreach (inst_db[db_ls])
         inst_db[db_ls] = 0;
@@ -180,27 +390,574 @@ class pktlib_main_class extends pktlib_object_class; // {
         foreach (hdr_q[db_ls])
            inst_db[hdr_q[db_ls].hid]++;  
     end // }
-    this.first_hdr.unpack_hdr (copy_pkt, index, hdr_q, mode);
-    hdr_q = {};
-    pkt   = new [ppkt.size] (ppkt);
+    this.first_hdr.hdr_stk.clr_trl_sum ();
+    // unpack in this.pkt. Hdrs only reshape it by reallocating (pad chop,
+    // decrypt), raw pkt is copied again only then. data_view leaves data/pad
+    // as views in to pkt, or in to view_buf if pkt got reshaped
+    pkt = ppkt;
+    this.first_hdr.unpack_hdr (pkt, index, hdr_q, mode);
+    view_in_pkt = data_view;
+    view_buf.delete ();
+    if (pkt.size != ppkt.size)
+    begin // {
+        if (data_view)
+            view_buf = pkt;
+        view_in_pkt = 1'b0;
+        pkt         = ppkt;
+    end // }
+    if (mode == SMART_UNPACK)
+    begin // {
+        hdr_sig = 64'hcbf29ce484222325 ^ pkt_format;
+        foreach (first_hdr.hdr_stk.all_hdr[ls])
+            hdr_sig = hdr_sig_step (hdr_sig, first_hdr.hdr_stk.all_hdr[ls]);
+    end // }
+    hdr_q       = {};
+    fld_map_vld = 1'b0;
+    // pkts unpacked by pktlib for its own use (compare, history) are not numbered
+    if (~pktlib_display_class::rec_busy)
+        dsp_pkt_no = ++pktlib_display_class::dsp_pkt_cnt;
+    if ((pktlib_display_class::rec_depth > 0) & ~pktlib_display_class::rec_busy)
+        rec_pkt (1'b1);
+    `ifdef PKTLIB_DPI_TRACE
+    if ((pktlib_display_class::trc_hdl >= 0) & ~pktlib_display_class::rec_busy)
+        trace_pkt (pkt, TRC_UNPACK);
+    `endif
+    if (acct_en)
+        acct_pkt ();
+    `PROF_END ("unpack_hdr", "pktlib")
   endtask : unpack_hdr // }
 
-  // This task copies all hdrs of the input class to this class 
+  // This function walks the hdrs of ppkt like SMART_UNPACK, but only records
+  // {hid, inst_no, start_off, hdr_len} of each layer in layer_q. No hdr
+  // object is populated. max_depth (0 = all) stops the walk after that many
+  // layers. A hdr without flat parser (or truncated) ends the walk and its
+  // hdr_len covers rest of the pkt. CRC and toh.pad_len are not reported
+  function void parse_layers (ref   bit [7:0]      ppkt [],
+                              ref   pktlib_layer_t layer_q [$],
+                              input int            max_depth = 0,
+                              input int            p_format  = IEEE802); // {
+    int       inst_cnt [TOTAL_HID];
+    int       hid, nxt_hid, index, end_off, len;
+    layer_q.delete ();
+    case (p_format) // { 
+        FC             : hid = FC_HID;
+        MIPI_CSI2_DPHY : hid = DPHY_HID;
+        default        : hid = ETH_HID;
+    endcase // }
+    end_off = get_trl_off (ppkt.size, p_format);
+    index   = 0;
+    while ((index < end_off) & ((max_depth == 0) | (layer_q.size < max_depth)))
+    begin // {
+        nxt_hid = DATA_HID;
+        if (hid == DATA_HID)
+            len = -1;
+        else
+            len = hdr_db[hid][0].parse_flat (ppkt, index, nxt_hid);
+        if ((len <= 0) | ((index + len) > end_off))
+        begin // {
+            layer_q.push_back ('{hid, inst_cnt[hid], index, end_off - index});
+            break;
+        end // }
+        layer_q.push_back ('{hid, inst_cnt[hid], index, len});
+        inst_cnt[hid]++;
+        index += len;
+        hid    = hdr_db[hid][0].unpack_en[nxt_hid] ? nxt_hid : DATA_HID;
+    end // }
+  endfunction : parse_layers // }
+
+  // This function returns offset of crc/pad (toh.pad_len) at end of pkt
+  function int get_trl_off (int pkt_sz,
+                            int p_format = IEEE802); // {
+    toh_class lcl_toh;
+    $cast (lcl_toh, hdr_db[TOP_HID][0]);
+    get_trl_off = pkt_sz - lcl_toh.pad_len;
+    if (lcl_toh.cal_n_add_crc & (p_format != MIPI_CSI2_DPHY))
+        get_trl_off -= 4;
+  endfunction : get_trl_off // }
+
+  // This function returns outer (first ip hdr) and inner (last ip hdr after
+  // a tunnel) flow keys of ppkt and their 64 bit hash. With PKTLIB_DPI_FLOW
+  // the native walker is used (tunnel ports of udp[0]/tcp[0] are passed to
+  // it) if flow_dpi_ok, else parse_layers. Both give the same hash
+  function bit [63:0] get_flow_key (ref    bit [7:0]         ppkt [],
+                                    output pktlib_flow_key_t outer,
+                                    output pktlib_flow_key_t inner,
+                                    input  int               p_format = IEEE802); // {
+    pktlib_layer_t    layer_q [$];
+    pktlib_flow_key_t key [2];
+    int               n_ip, k, off;
+    `ifdef PKTLIB_DPI_FLOW
+    if (flow_dpi_ok ())
+        return pv_flow_key (ppkt, get_trl_off (ppkt.size, p_format),
+                            hdr_db[UDP_HID][0].vxlan_udp_dst_prt, hdr_db[UDP_HID][0].lisp_udp_dst_prt,
+                            hdr_db[UDP_HID][0].otv_udp_dst_prt,   hdr_db[TCP_HID][0].stt_tcp_dst_prt,
+                            outer, inner);
+    `endif
+    parse_layers (ppkt, layer_q, 0, p_format);
+    n_ip = 0;
+    k    = 0;
+    foreach (layer_q[ls])
+    begin // {
+        off = layer_q[ls].start_off;
+        case (layer_q[ls].hid) // {
+            IPV4_HID :
+            begin // {
+                k               = (n_ip != 0);
+                n_ip++;
+                key[k]          = '0;
+                key[k].ip_ver   = 4;
+                key[k].ip_sa    = {ppkt[off+12], ppkt[off+13], ppkt[off+14], ppkt[off+15]};
+                key[k].ip_da    = {ppkt[off+16], ppkt[off+17], ppkt[off+18], ppkt[off+19]};
+                key[k].protocol = ppkt[off+9];
+                // non first fragment carries no l4 hdr
+                if ({ppkt[off+6][4:0], ppkt[off+7]} != 0)
+                    break;
+            end // }
+            IPV6_HID :
+            begin // {
+                k               = (n_ip != 0);
+                n_ip++;
+                key[k]          = '0;
+                key[k].ip_ver   = 6;
+                key[k].ip_sa    = {>>{ppkt[off+8  +: 16]}};
+                key[k].ip_da    = {>>{ppkt[off+24 +: 16]}};
+                key[k].protocol = ppkt[off+6];
+            end // }
+            IPV6_HOPOPT_HID, IPV6_ROUT_HID, IPV6_FRAG_HID, IPV6_OPTS_HID :
+                if (n_ip != 0)
+                    key[k].protocol = ppkt[off];
+            UDP_HID, TCP_HID :
+                if (n_ip != 0)
+                    {key[k].src_prt, key[k].dst_prt} = {ppkt[off], ppkt[off+1], ppkt[off+2], ppkt[off+3]};
+        endcase // }
+    end // }
+    outer        = key[0];
+    inner        = key[1];
+    get_flow_key = flow_hash (outer, inner);
+  endfunction : get_flow_key // }
+
+  // This function returns 1 if the native flow walker (flow_dpi.c) parses
+  // like parse_layers, i.e. no add_transition and default etypes/protocols
+  // on the hdrs it walks
+  function bit flow_dpi_ok (); // {
+    int       l2_hid [5] = '{ETH_HID, DOT1Q_HID, ALT1Q_HID, STAG_HID, GRE_HID};
+    int       l3_hid [6] = '{IPV4_HID, IPV6_HID, IPV6_HOPOPT_HID, IPV6_ROUT_HID, IPV6_FRAG_HID, IPV6_OPTS_HID};
+    hdr_class h;
+    if (pktlib_parse_graph_class::cust_tbl.num () != 0)
+        return 1'b0;
+    foreach (l2_hid[i])
+    begin // {
+        h = hdr_db[l2_hid[i]][0];
+        if ((h != null) && ((h.dot1q_etype != `DOT1Q_HDR_ETYPE) | (h.alt1q_etype != `ALT1Q_HDR_ETYPE) |
+            (h.stag_etype  != `STAG_HDR_ETYPE)  | (h.mpls_etype  != `MPLS_HDR_ETYPE)  |
+            (h.mmpls_etype != `MMPLS_HDR_ETYPE) | (h.ipv4_etype  != `IPV4_HDR_ETYPE)  |
+            (h.ipv6_etype  != `IPV6_HDR_ETYPE)  | (h.eth_etype   != `ETH_HDR_ETYPE)))
+            return 1'b0;
+    end // }
+    foreach (l3_hid[i])
+    begin // {
+        h = hdr_db[l3_hid[i]][0];
+        if ((h != null) && ((h.ipv4_prot        != `IPV4_HDR_PROT)    | (h.ipv6_prot      != `IPV6_HDR_PROT)  |
+            (h.ipv6_hopopt_prot != `IPV6_HOPOPT_PROT) | (h.ipv6_rout_prot != `IPV6_ROUT_PROT) |
+            (h.ipv6_frag_prot   != `IPV6_FRAG_PROT)   | (h.ipv6_opts_prot != `IPV6_OPTS_PROT) |
+            (h.gre_prot         != `GRE_HDR_PROT)     | (h.udp_prot       != `UDP_HDR_PROT)   |
+            (h.tcp_prot         != `TCP_HDR_PROT)))
+            return 1'b0;
+    end // }
+    return 1'b1;
+  endfunction : flow_dpi_ok // }
+
+  // This function returns FNV-1a 64 hash of {outer, inner} flow keys
+  static function bit [63:0] flow_hash (pktlib_flow_key_t outer,
+                                        pktlib_flow_key_t inner); // {
+    bit [7:0] key_b [];
+    key_b     = {>>{outer, inner}};
+    flow_hash = 64'hcbf29ce484222325;
+    foreach (key_b[i])
+        flow_hash = (flow_hash ^ key_b[i]) * 64'h100000001b3;
+  endfunction : flow_hash // }
+
+  // This task patches one field of the already packed pkt in place. Affected
+  // L3/L4 checksums are updated with RFC 1624 arithmetic and FCS with crc32
+  // combine, so no repack is needed. Patched pkt is available in this.pkt
+  // For E.g. -> patch_field (ipv4[0], "ttl", 8'h3f);
+  // Fields which change hdr lengths (ihl, offset, data_len, ...) need a repack
+  task patch_field (hdr_class         hdr,
+                    string            field,
+                    bit [`VEC_SZ-1:0] value,
+                    bit               refresh = 1'b1); // {
+    bit [7:0] org_byte [int]; // original value of each modified byte
+    if ((pkt.size == 0) | pkt_modified)
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : patch_field %0s.%0s needs unmodified pkt from pack_hdr", $time, hdr.hdr_name, field);
+        return;
+    end // }
+    if (~fld_map_vld)
+        build_fld_map ();
+    if (write_field (hdr, field, value, org_byte))
+        fix_patched_pkt (org_byte, refresh);
+  endtask : patch_field // }
+
+  // This function writes new value of a field msb first and remembers
+  // original value of each modified byte. Returns 0 if field is not found
+  function bit write_field (      hdr_class         hdr,
+                                  string            field,
+                                  bit [`VEC_SZ-1:0] value,
+                            ref   bit [7:0]         org_byte [int]); // {
+    int fld_off, fld_sz, byte_off, bit_pos;
+    if (~hfld.fld_off.exists ({hdr.hdr_name, ".", field}))
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : patch_field can't find field %0s.%0s", $time, hdr.hdr_name, field);
+        return 1'b0;
+    end // }
+    fld_off = hfld.fld_off [{hdr.hdr_name, ".", field}];
+    fld_sz  = hfld.fld_sz  [{hdr.hdr_name, ".", field}];
+    for (int i = 0; i < fld_sz; i++)
+    begin // {
+        byte_off = (fld_off + i)/8;
+        bit_pos  = 7 - ((fld_off + i) % 8);
+        if (byte_off >= pkt.size)
+            break;
+        if (~org_byte.exists (byte_off))
+            org_byte [byte_off] = pkt [byte_off];
+        pkt [byte_off][bit_pos] = value [fld_sz - 1 - i];
+    end // }
+    return 1'b1;
+  endfunction : write_field // }
+
+  // This task fixes checksums and FCS for all the bytes written by
+  // write_field, and reloads fields of modified hdrs if refresh is set
+  task fix_patched_pkt (ref   bit [7:0] org_byte [int],
+                        input bit       refresh = 1'b1); // {
+    bit [7:0] usr_byte [int]; // bytes patched by user
+    usr_byte = org_byte;
+    // fix checksums from innermost hdr outwards, so outer checksums see inner checksum updates
+    for (int i = first_hdr.hdr_stk.all_hdr.size - 1; i >= 0; i--)
+        patch_chksm (first_hdr.hdr_stk.all_hdr[i], org_byte, usr_byte);
+    patch_fcs (org_byte, usr_byte);
+    if (~refresh)
+        return;
+    // reload fields of all hdrs which got modified
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+    begin // {
+        foreach (org_byte[off])
+        begin // {
+            if ((off >= first_hdr.hdr_stk.all_hdr[ls].start_off) & 
+                (off <  first_hdr.hdr_stk.all_hdr[ls].start_off + first_hdr.hdr_stk.all_hdr[ls].hdr_len))
+            begin // {
+                refresh_hdr (first_hdr.hdr_stk.all_hdr[ls]);
+                break;
+            end // }
+        end // }
+    end // }
+  endtask : fix_patched_pkt // }
+
+  // This task adds a field variation to pkt template. Each nxt_tmpl_pkt
+  // call patches field with next value, no randomize/pack needed
+  // For E.g. -> add_fld_var (udp[0], "src_prt", FLD_INCR, 16'h1000);
+  //             add_fld_var (ipv4[0], "ip_da", FLD_RND, .min_val(32'h0a000000), .max_val(32'h0a0000ff));
+  task add_fld_var (hdr_class         hdr,
+                    string            field,
+                    int               var_type  = FLD_INCR,
+                    bit [`VEC_SZ-1:0] start_val = 0,
+                    bit [`VEC_SZ-1:0] step      = 1,
+                    bit [`VEC_SZ-1:0] min_val   = 0,
+                    bit [`VEC_SZ-1:0] max_val   = '1,
+                    bit [`VEC_SZ-1:0] val_list [$] = {}); // {
+    pktlib_fld_var_class fld_var;
+    fld_var = new (hdr, field, var_type, start_val, step, min_val, max_val, val_list);
+    fld_var_q.push_back (fld_var);
+  endtask : add_fld_var // }
+
+  // This task removes all the field variations of pkt template
+  task clr_fld_var (); // {
+    fld_var_q.delete ();
+  endtask : clr_fld_var // }
+
+  // This task generates next pkt from template (pkt of last pack_hdr) by
+  // patching all the fields added by add_fld_var. Checksums and FCS are
+  // fixed once per pkt. Hdr fields are reloaded only if refresh is set
+  task nxt_tmpl_pkt (ref   bit [7:0] ppkt [],
+                     input bit       refresh = 1'b0); // {
+    bit [7:0] org_byte [int];
+    bit       vld = 1'b0;
+    if ((pkt.size == 0) | pkt_modified)
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : nxt_tmpl_pkt needs unmodified pkt from pack_hdr", $time);
+        return;
+    end // }
+    if (~fld_map_vld)
+        build_fld_map ();
+    foreach (fld_var_q[ls])
+        vld |= write_field (fld_var_q[ls].hdr, fld_var_q[ls].field, fld_var_q[ls].nxt_val (), org_byte);
+    if (vld)
+        fix_patched_pkt (org_byte, refresh);
+    ppkt = pkt;
+  endtask : nxt_tmpl_pkt // }
+
+  // This task records bit offset/size of every field of pkt (used by patch_field)
+  task build_fld_map (); // {
+    hfld = new ();
+    this.first_hdr.display_hdr (hfld, this.first_hdr, FIELD_MAP);
+    fld_map_vld = 1'b1;
+  endtask : build_fld_map // }
+
+  // This function gets the region covered by checksum of a hdr
+  function void get_chksm_info (input  hdr_class h,
+                                output bit       vld,
+                                output int       c_st,
+                                output int       c_end,
+                                output int       c_off,
+                                output bit       use_pseudo); // {
+    ipv4_hdr_class lcl_ip4;
+    tcp_hdr_class  lcl_tcp;
+    udp_hdr_class  lcl_udp;
+    icmp_hdr_class lcl_icmp;
+    igmp_hdr_class lcl_igmp;
+    gre_hdr_class  lcl_gre;
+    vld        = 1'b0;
+    use_pseudo = 1'b0;
+    c_st       = h.start_off;
+    c_end      = pkt.size - first_hdr.get_crc_sz ();
+    c_off      = 0;
+    case (h.hid) // {
+        IPV4_HID   :
+        begin // {
+            $cast (lcl_ip4, h);
+            vld   = lcl_ip4.cal_ip_chksm;
+            c_end = c_st + h.hdr_len;
+        end // }
+        TCP_HID    :
+        begin // {
+            $cast (lcl_tcp, h);
+            vld        = lcl_tcp.cal_tcp_chksm;
+            use_pseudo = 1'b1;
+        end // }
+        UDP_HID    :
+        begin // {
+            $cast (lcl_udp, h);
+            vld        = lcl_udp.cal_udp_chksm;
+            use_pseudo = 1'b1;
+        end // }
+        ICMP_HID   :
+        begin // {
+            $cast (lcl_icmp, h);
+            vld   = lcl_icmp.cal_icmp_chksm;
+            c_end = c_st + h.hdr_len;
+        end // }
+        ICMPV6_HID :
+        begin // {
+            $cast (lcl_icmp, h);
+            vld        = lcl_icmp.cal_icmp_chksm;
+            use_pseudo = 1'b1;
+        end // }
+        IGMP_HID   :
+        begin // {
+            $cast (lcl_igmp, h);
+            vld = lcl_igmp.cal_igmp_chksm;
+        end // }
+        GRE_HID    :
+        begin // {
+            $cast (lcl_gre, h);
+            vld = lcl_gre.cal_chksm & (lcl_gre.C | lcl_gre.R);
+        end // }
+    endcase // }
+    if (vld & hfld.fld_off.exists ({h.hdr_name, ".checksum"}))
+        c_off = hfld.fld_off [{h.hdr_name, ".checksum"}]/8;
+    else
+        vld = 1'b0;
+  endfunction : get_chksm_info // }
+
+  // This function returns byte lane (0 -> msb, 1 -> lsb) of ip hdr byte in 
+  // pseudo hdr used by L4 checksum, -1 if byte is not part of pseudo hdr.
+  // Length word is not a copy of ip hdr bytes, see pseudo_len
+  function int pseudo_lane (int hid,
+                            int rel_off); // {
+    pseudo_lane = -1;
+    case (hid) // {
+        IPV4_HID : // protocol, ip_sa, ip_da
+        begin // {
+            if ((rel_off inside {[12:19]}))
+                pseudo_lane = rel_off % 2;
+            else if (rel_off == 9)
+                pseudo_lane = 1;
+        end // }
+        IPV6_HID, GRH_HID : // protocol, sa, da
+        begin // {
+            if ((rel_off inside {[8:39]}))
+                pseudo_lane = rel_off % 2;
+            else if (rel_off == 6)
+                pseudo_lane = 1;
+        end // }
+    endcase // }
+  endfunction : pseudo_lane // }
+
+  // This function returns length word of pseudo hdr used by L4 checksum,
+  // total_length - ihl*4 for ipv4 and payload_len for ipv6/grh (same as
+  // cal_pseudo_chksm). Original bytes from org_byte are used if org is set
+  function bit [15:0] pseudo_len (      hdr_class ip_hdr,
+                                  ref   bit [7:0] org_byte [int],
+                                  input bit       org); // {
+    bit [7:0] b [4];
+    int       off;
+    foreach (b[i])
+    begin // {
+        off  = ip_hdr.start_off + i + ((ip_hdr.hid == IPV4_HID) ? 0 : 4);
+        b[i] = (org & org_byte.exists (off)) ? org_byte[off] : pkt[off];
+    end // }
+    if (ip_hdr.hid == IPV4_HID)
+        pseudo_len = {b[2], b[3]} - (b[0][3:0] * 4);
+    else
+        pseudo_len = {b[0], b[1]};
+  endfunction : pseudo_len // }
+
+  // This task updates checksum of a hdr for all the modified bytes (RFC 1624)
+  task patch_chksm (    hdr_class h,
+                    ref bit [7:0] org_byte [int],
+                    ref bit [7:0] usr_byte [int]); // {
+    bit        vld, use_pseudo;
+    int        c_st, c_end, c_off, lane, i;
+    bit [15:0] chksm, old_len, new_len;
+    hdr_class  ip_hdr;
+    get_chksm_info (h, vld, c_st, c_end, c_off, use_pseudo);
+    // checksum field itself is patched by user, leave it as is
+    if (~vld || usr_byte.exists (c_off) || usr_byte.exists (c_off+1))
+        return;
+    chksm = {pkt[c_off], pkt[c_off+1]};
+    foreach (org_byte[off])
+    begin // {
+        if ((off >= c_st) & (off < c_end) & ((off < c_off) | (off > c_off+1)))
+        begin // {
+            if ((off - c_st) % 2)
+                chksm = h.crc_chksm.chksm16_update (chksm, org_byte[off], pkt[off]);
+            else
+                chksm = h.crc_chksm.chksm16_update (chksm, {org_byte[off], 8'h0}, {pkt[off], 8'h0});
+        end // }
+    end // }
+    // pseudo hdr comes from last ip hdr before this hdr
+    if (use_pseudo)
+    begin // {
+        ip_hdr = null;
+        for (i = 0; i < h.cfg_id; i++)
+        begin // {
+            if ((first_hdr.hdr_stk.all_hdr[i].hid == IPV4_HID) | (first_hdr.hdr_stk.all_hdr[i].hid == IPV6_HID) |
+                ((first_hdr.hdr_stk.all_hdr[i].hid == GRH_HID) & (h.hid != ICMPV6_HID)))
+                ip_hdr = first_hdr.hdr_stk.all_hdr[i];
+        end // }
+        if (ip_hdr != null)
+        begin // {
+            foreach (org_byte[off])
+            begin // {
+                lane = pseudo_lane (ip_hdr.hid, off - ip_hdr.start_off);
+                if (lane == 1)
+                    chksm = h.crc_chksm.chksm16_update (chksm, org_byte[off], pkt[off]);
+                else if (lane == 0)
+                    chksm = h.crc_chksm.chksm16_update (chksm, {org_byte[off], 8'h0}, {pkt[off], 8'h0});
+            end // }
+            // length word is folded as a whole, ipv4 one depends on total_length and ihl
+            old_len = pseudo_len (ip_hdr, org_byte, 1'b1);
+            new_len = pseudo_len (ip_hdr, org_byte, 1'b0);
+            if (old_len != new_len)
+                chksm = h.crc_chksm.chksm16_update (chksm, old_len, new_len);
+        end // }
+    end // }
+    if (chksm != {pkt[c_off], pkt[c_off+1]})
+    begin // {
+        if (~org_byte.exists (c_off))
+            org_byte [c_off]   = pkt [c_off];
+        if (~org_byte.exists (c_off+1))
+            org_byte [c_off+1] = pkt [c_off+1];
+        {pkt[c_off], pkt[c_off+1]} = chksm;
+    end // }
+  endtask : patch_chksm // }
+
+  // This task updates FCS for all the modified bytes using crc32 combine
+  task patch_fcs (ref bit [7:0] org_byte [int],
+                  ref bit [7:0] usr_byte [int]); // {
+    toh_class  lcl_toh;
+    bit [7:0]  diff [];
+    bit [31:0] crc_reg;
+    int        crc_sz, fcs_off, first_off, last_off, usr_end = 0;
+    $cast (lcl_toh, first_hdr);
+    crc_sz  = first_hdr.get_crc_sz ();
+    fcs_off = pkt.size - crc_sz;
+    void'(usr_byte.last (usr_end));
+    // FCS itself is patched by user, leave it as is
+    if (~lcl_toh.cal_n_add_crc | (crc_sz == 0) | (org_byte.size == 0) | (usr_end >= fcs_off))
+        return;
+    if (crc_sz == 4)
+    begin // {
+        void'(org_byte.first (first_off));
+        void'(org_byte.last  (last_off));
+        diff = new [last_off - first_off + 1];
+        foreach (org_byte[off])
+            diff [off - first_off] = org_byte[off] ^ pkt[off];
+        crc_reg  = ~{pkt[fcs_off+3], pkt[fcs_off+2], pkt[fcs_off+1], pkt[fcs_off]};
+        crc_reg ^= lcl_toh.crc_chksm.crc32_zero_ext (lcl_toh.crc_chksm.crc32_raw (diff, diff.size, 0),
+                                                     fcs_off - last_off - 1);
+        {pkt[fcs_off+3], pkt[fcs_off+2], pkt[fcs_off+1], pkt[fcs_off]} = ~crc_reg;
+        lcl_toh.crc32 = {pkt[fcs_off], pkt[fcs_off+1], pkt[fcs_off+2], pkt[fcs_off+3]};
+    end // }
+    else
+    begin // {
+        // 16 bit crc is short, recompute it same as toh_class
+        lcl_toh.crc16 = lcl_toh.crc_chksm.crc32 (pkt, fcs_off, 0, lcl_toh.corrupt_crc);
+        {pkt[fcs_off], pkt[fcs_off+1]} = lcl_toh.crc16;
+    end // }
+  endtask : patch_fcs // }
+
+  // This task reloads fields of a hdr from patched pkt
+  task refresh_hdr (hdr_class h); // {
+    hdr_class  lcl_q [$];
+    data_class lcl_data;
+    int        idx;
+    bit [15:0] total_hdr_len, hdr_len, trl_len;
+    int        start_off;
+    if ((h.hid == TOP_HID) | (h.hid == EOH_HID))
+        return;
+    if (h.hid == DATA_HID)
+    begin // {
+        $cast (lcl_data, h);
+        lcl_data.fetch_view ();
+        foreach (lcl_data.data[ls])
+            lcl_data.data[ls] = pkt[h.start_off + ls];
+        return;
+    end // }
+    total_hdr_len   = h.total_hdr_len;
+    hdr_len         = h.hdr_len;
+    trl_len         = h.trl_len;
+    start_off       = h.start_off;
+    idx             = h.start_off;
+    h.unpack_hdr (pkt, idx, lcl_q, DUMB_UNPACK, 1'b1);
+    h.total_hdr_len = total_hdr_len;
+    h.hdr_len       = hdr_len;
+    h.trl_len       = trl_len;
+    h.start_off     = start_off;
+  endtask : refresh_hdr // }
+
+  // This task copies all hdrs of the input class to this class. COPY_LITE
+  // shares hdrs with input class (no hdr field is copied), COPY_DEEP copies
+  // only the present hdrs (all_hdr) in to this class's own hdrs and relinks them
   task cpy_hdr (pktlib_object_class cpy_cls,
                 int                 mode = COPY_LITE); // {
-    pktlib_main_class cpy_frm;
-    pktlib_class      cp_2, cp_frm;
+    `PROF_BEGIN
+    pktlib_main_class      cpy_frm;
+    hdr_class              src, dst, lcl_q [$];
+    pktlib_array_class     lcl_harray;
+    pktlib_crc_chksm_class lcl_crc_chksm;
     $cast (cpy_frm, cpy_cls);
+    if (view_in_pkt)
+        fetch_views ();
     this.hdis         = cpy_frm.hdis;
-    this.hdr_db       = cpy_frm.hdr_db;
     this.inst_db      = cpy_frm.inst_db;
-    this.first_hdr    = cpy_frm.first_hdr;
-    this.hdr_q        = cpy_frm.hdr_q;  
     this.org_pkt      = cpy_frm.org_pkt;
     this.pkt          = cpy_frm.pkt;
     this.pkt_modified = cpy_frm.pkt_modified;
     this.cfg_hdr_list = cpy_frm.cfg_hdr_list;
+    this.hdr_sig      = cpy_frm.hdr_sig;
+    this.fld_map_vld  = 1'b0;
     this.pkt_format   = cpy_frm.pkt_format;
+    this.use_solver   = cpy_frm.use_solver;
     this.pid          = cpy_frm.pid;        
     this.path         = cpy_frm.path;        
     this.pnum         = cpy_frm.pnum;        
@@ -214,43 +971,278 @@ class pktlib_main_class extends pktlib_object_class; // {
     this.dsc_32       = cpy_frm.dsc_32;  
     this.dsc_64       = cpy_frm.dsc_64;                
     if (mode === COPY_LITE)
-        this.first_hdr.cpy_hdr (cpy_frm.first_hdr);
+    begin // {
+        this.hdr_db       = cpy_frm.hdr_db;
+        this.first_hdr    = cpy_frm.first_hdr;
+        this.hdr_q        = cpy_frm.hdr_q;  
+        this.hdr_stk.ref_cnt--;
+        this.hdr_stk      = cpy_frm.hdr_stk;
+        this.hdr_stk.ref_cnt++;
+    end // }
     else
     begin // {
-        $cast (cp_frm, cpy_cls);
-        foreach (hdr_db[hdr_ls, inst_ls])
+        // map present hdrs on to hdrs of this class with same hid/inst_no
+        foreach (cpy_frm.first_hdr.hdr_stk.all_hdr[ls])
+        begin // {
+            src = cpy_frm.first_hdr.hdr_stk.all_hdr[ls];
+            dst = hdr_db[src.hid][src.inst_no];
+            if (dst == null)
+            begin // {
+                $display ("%0t : ERROR   : pkt_lib   : cpy_hdr COPY_DEEP, %0s[%0d] not present in this pktlib", $time, src.hdr_name, src.inst_no);
+                `PROF_END ("cpy_hdr", "pktlib")
+                return;
+            end // }
+            lcl_q.push_back (dst);
+        end // }
+        if (hdr_stk.ref_cnt > 1)
         begin // {
-           cp_2 = new();
-           if (cp_frm.hdr_db[hdr_ls][inst_ls] != null)
-             cp_2.hdr_db[hdr_ls][inst_ls].cpy_hdr (cp_frm.hdr_db[hdr_ls][inst_ls], 1'b1);
+            hdr_stk.ref_cnt--;
+            hdr_stk = new ();
         end // }
+        hdr_stk.all_hdr = lcl_q;
+        hdr_stk.clr_trl_sum ();
+        // copy fields, keep own plib/harray/crc_chksm and remap links
+        foreach (lcl_q[ls])
+        begin // {
+            src           = cpy_frm.first_hdr.hdr_stk.all_hdr[ls];
+            dst           = lcl_q[ls];
+            lcl_harray    = dst.harray;
+            lcl_crc_chksm = dst.crc_chksm;
+            dst.cpy_hdr (src, 1'b1);
+            dst.plib                = this;
+            dst.hdr_stk             = hdr_stk;
+            dst.harray              = lcl_harray;
+            dst.harray.data_pattern = src.harray.data_pattern;
+            dst.harray.start_byte   = src.harray.start_byte;
+            dst.crc_chksm           = lcl_crc_chksm;
+            dst.prv_hdr             = (src.prv_hdr == null) ? null : hdr_db[src.prv_hdr.hid][src.prv_hdr.inst_no];
+            dst.nxt_hdr             = (src.nxt_hdr == null) ? null : hdr_db[src.nxt_hdr.hid][src.nxt_hdr.inst_no];
+        end // }
+        this.first_hdr = hdr_db[cpy_frm.first_hdr.hid][cpy_frm.first_hdr.inst_no];
+        this.hdr_q     = {};
+        foreach (cpy_frm.hdr_q[ls])
+            this.hdr_q.push_back (hdr_db[cpy_frm.hdr_q[ls].hid][cpy_frm.hdr_q[ls].inst_no]);
     end // }
+    `PROF_END ("cpy_hdr", "pktlib")
   endtask : cpy_hdr // }
 
+  // This function keeps raw pkt in flight recorder ring of its stream (pnum)
+  function void rec_pkt (bit is_unpack); // {
+    toh_class lcl_toh;
+    int       idx;
+    if (~pktlib_display_class::rec_buf.exists (pnum))
+    begin // {
+        pktlib_display_class::rec_buf [pnum] = new [pktlib_display_class::rec_depth];
+        pktlib_display_class::rec_wr  [pnum] = 0;
+    end // }
+    $cast (lcl_toh, first_hdr);
+    idx = pktlib_display_class::rec_wr [pnum] % pktlib_display_class::rec_depth;
+    pktlib_display_class::rec_buf [pnum][idx].pkt        = pkt;
+    pktlib_display_class::rec_buf [pnum][idx].hdr_sig    = hdr_sig;
+    pktlib_display_class::rec_buf [pnum][idx].pkt_format = pkt_format;
+    pktlib_display_class::rec_buf [pnum][idx].crc_psnt   = lcl_toh.cal_n_add_crc;
+    pktlib_display_class::rec_buf [pnum][idx].is_unpack  = is_unpack;
+    pktlib_display_class::rec_buf [pnum][idx].pid        = pid;
+    pktlib_display_class::rec_buf [pnum][idx].path       = path;
+    pktlib_display_class::rec_buf [pnum][idx].rec_time   = $time;
+    pktlib_display_class::rec_wr  [pnum]++;
+  endfunction : rec_pkt // }
+
+  `ifdef PKTLIB_DPI_TRACE
+  // This function opens binary pkt trace file, pack_hdr/unpack_hdr/
+  // compare_pkt of all pktlibs append records to it till trace_close.
+  // Decode with test/pktlib_trace_decode.sv or scripts/pktlib_trace_decode
+  static function bit trace_open (string fname); // {
+    pktlib_display_class::trc_hdl = pv_trace_open (fname, 0);
+    if (pktlib_display_class::trc_hdl < 0)
+        $display ("%0t : ERROR   : pkt_lib   : trace_open can't open %0s", $time, fname);
+    return (pktlib_display_class::trc_hdl >= 0);
+  endfunction : trace_open // }
+
+  static function void trace_close (); // {
+    if (pktlib_display_class::trc_hdl >= 0)
+        pv_trace_close (pktlib_display_class::trc_hdl);
+    pktlib_display_class::trc_hdl = -1;
+  endfunction : trace_close // }
+
+  // This function appends a pkt record to binary trace, no formatting
+  function void trace_pkt (ref   bit [7:0] p [],
+                           input int       status); // {
+    pv_trace_write (pktlib_display_class::trc_hdl, p, p.size, hdr_sig, $time,
+                    pid, pnum, path, drv_ctrl, pkt_format, status);
+  endfunction : trace_pkt // }
+
+  // This function opens pkt corpus of this pktlib, keyed by config hash
+  // (hdr_sig, plen limits, crc, cfg_tag for user constraints) and seed, in
+  // dir. Corpus is replayed if it exists (returns 1), else it is written by
+  // corpus_put and pktlib is seeded with seed. cfg_hdr must be done before.
+  // For E.g. -> p.corpus_get (pkt, hit); if (~hit) begin randomize; pack_hdr (pkt); corpus_put (); end
+  function bit corpus_open (string     dir,
+                            bit [63:0] seed,
+                            string     cfg_tag = ""); // {
+    toh_class  lcl_toh;
+    bit [63:0] cfg_hash;
+    string     fname;
+    $cast (lcl_toh, first_hdr);
+    cfg_hash = hdr_sig;
+    cfg_hash = (cfg_hash ^ lcl_toh.min_plen)      * 64'h100000001b3;
+    cfg_hash = (cfg_hash ^ lcl_toh.max_plen)      * 64'h100000001b3;
+    cfg_hash = (cfg_hash ^ lcl_toh.cal_n_add_crc) * 64'h100000001b3;
+    foreach (cfg_tag[i])
+        cfg_hash = (cfg_hash ^ cfg_tag[i]) * 64'h100000001b3;
+    corpus_close ();
+    $sformat (fname, "%0s/corpus_%h_%0h.bin", dir, cfg_hash, seed);
+    corpus_hdl = pv_trace_open (fname, 1);
+    corpus_rd  = (corpus_hdl >= 0);
+    if (~corpus_rd)
+    begin // {
+        this.srandom (seed);
+        seed_prng    (seed);
+        corpus_hdl = pv_trace_open (fname, 0);
+        if (corpus_hdl < 0)
+            $display ("%0t : ERROR   : pkt_lib   : corpus_open can't open %0s", $time, fname);
+    end // }
+    return corpus_rd;
+  endfunction : corpus_open // }
+
+  function void corpus_close (); // {
+    if (corpus_hdl >= 0)
+        pv_trace_close (corpus_hdl);
+    corpus_hdl = -1;
+    corpus_rd  = 1'b0;
+  endfunction : corpus_close // }
+
+  // This task gets next pkt of a replayed corpus in to ppkt and DUMB_UNPACKs
+  // it (no randomize/pack). hit is 0 if corpus is not replayed or has ended
+  task corpus_get (ref    bit [7:0] ppkt [],
+                   output bit       hit); // {
+    longint lcl_sig, lcl_time;
+    int     len, status;
+    hit = 1'b0;
+    if (~corpus_rd)
+        return;
+    len = pv_trace_read (corpus_hdl, lcl_sig, lcl_time, pid, pnum, path, drv_ctrl, pkt_format, status);
+    if (len < 0)
+        return;
+    if (lcl_sig != hdr_sig)
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : corpus_get hdr_sig %h of corpus pkt, pktlib has %h", $time, lcl_sig, hdr_sig);
+        return;
+    end // }
+    ppkt = new [len];
+    pv_trace_get_pkt (corpus_hdl, ppkt);
+    unpack_hdr (ppkt, DUMB_UNPACK);
+    hit = 1'b1;
+  endtask : corpus_get // }
+
+  // This function appends pkt of last pack_hdr to a corpus being written
+  function void corpus_put (); // {
+    if ((corpus_hdl >= 0) & ~corpus_rd)
+        pv_trace_write (corpus_hdl, pkt, pkt.size, hdr_sig, $time,
+                        pid, pnum, path, drv_ctrl, pkt_format, TRC_PACK);
+  endfunction : corpus_put // }
+  `endif
+
+  // This task unpacks and displays pkts kept by flight recorder, oldest
+  // first, for stream (pnum) or all streams (-1). Display policy is not
+  // applied. Displayed pkts are dropped from recorder if clr is set
+  task dump_history (int    stream    = -1,
+                     bit    clr       = 1'b1,
+                     string path_name = ""); // {
+    pktlib_class p;
+    int          dsp_policy, n, st;
+    bit          dsp_hid [int];
+    string       usr_comment;
+    pktlib_rec_t e;
+    if (pktlib_display_class::rec_buf.size == 0)
+        return;
+    dsp_policy = pktlib_display_class::dsp_policy;
+    dsp_hid    = pktlib_display_class::dsp_hid;
+    pktlib_display_class::dsp_policy = DSP_ALL;
+    pktlib_display_class::dsp_hid.delete ();
+    pktlib_display_class::rec_busy   = 1'b1;
+    p = new ();
+    foreach (pktlib_display_class::rec_buf[s_ls])
+    begin // {
+        if ((stream != -1) & (s_ls != stream))
+            continue;
+        n  = pktlib_display_class::rec_wr [s_ls];
+        st = (n > pktlib_display_class::rec_depth) ? (n - pktlib_display_class::rec_depth) : 0;
+        $display ("%0t : INFO    : pkt_lib   : Flight recorder, last %0d of %0d pkts of stream %0d", $time, n - st, n, s_ls);
+        for (int i = st; i < n; i++)
+        begin // {
+            e = pktlib_display_class::rec_buf [s_ls][i % pktlib_display_class::rec_depth];
+            p.toh.cal_n_add_crc = e.crc_psnt;
+            p.unpack_hdr (e.pkt, SMART_UNPACK,, e.pkt_format);
+            $sformat (usr_comment, "%0s pkt %0d, pid %0d, path %0d at %0t%0s", e.is_unpack ? "Unpacked" : "Packed", i+1, e.pid, e.path, e.rec_time,
+                      (p.hdr_sig == e.hdr_sig) ? "" : " (hdr stack differs from recorded one)");
+            p.display_hdr_pkt (e.pkt, path_name, "pkt_lib", usr_comment);
+        end // }
+        if (clr)
+            pktlib_display_class::rec_wr [s_ls] = 0;
+    end // }
+    pktlib_display_class::rec_busy   = 1'b0;
+    pktlib_display_class::dsp_policy = dsp_policy;
+    pktlib_display_class::dsp_hid    = dsp_hid;
+  endtask : dump_history // }
+
+  // This function checks global display policy (pktlib_display_class::
+  // set_dsp_policy) for this pkt, err is set by compares on a miscompare
+  function bit dsp_ok (bit err = 1'b0); // {
+    bit hid_ok;
+    hid_ok = (pktlib_display_class::dsp_hid.size == 0);
+    if (~hid_ok & (first_hdr != null))
+    begin // {
+        foreach (first_hdr.hdr_stk.all_hdr[ls])
+        begin // {
+            if (pktlib_display_class::dsp_hid.exists (first_hdr.hdr_stk.all_hdr[ls].hid))
+            begin // {
+                hid_ok = 1'b1;
+                break;
+            end // }
+        end // }
+    end // }
+    return (hid_ok & pktlib_display_class::dsp_pkt (dsp_pkt_no, err));
+  endfunction : dsp_ok // }
+
   // This task displays cfg_hdr
   task display_cfg_hdr (int mode        =  DISPLAY,
                         int min_hdrq_sz = 2); // {
-    foreach (first_hdr.all_hdr[ls])
+    `PROF_BEGIN
+    if ((mode != NO_DISPLAY) & ~dsp_ok ())
     begin // {
-        if (ls == (first_hdr.all_hdr.size - 1))
+        `PROF_END ("display_cfg_hdr", "pktlib")
+        return;
+    end // }
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+    begin // {
+        if (ls == (first_hdr.hdr_stk.all_hdr.size - 1))
             $sformat (cfg_hdr_list, "%0s} (%0s)", cfg_hdr_list, first_hdr.get_pkt_format_name(pkt_format));
         else if (ls == 0)
            $sformat (cfg_hdr_list,"{");
-        else if (ls <  (first_hdr.all_hdr.size- 2)) 
-            $sformat (cfg_hdr_list,"%0s%0s, ", cfg_hdr_list,first_hdr.all_hdr[ls].hdr_name);
+        else if (ls <  (first_hdr.hdr_stk.all_hdr.size- 2)) 
+            $sformat (cfg_hdr_list,"%0s%0s, ", cfg_hdr_list,first_hdr.hdr_stk.all_hdr[ls].hdr_name);
          else
-            $sformat (cfg_hdr_list,"%0s%0s", cfg_hdr_list,first_hdr.all_hdr[ls].hdr_name);
+            $sformat (cfg_hdr_list,"%0s%0s", cfg_hdr_list,first_hdr.hdr_stk.all_hdr[ls].hdr_name);
     end // }
     if (mode != NO_DISPLAY)
         $display ("    cfg_hdr : %0s", cfg_hdr_list);
+    `PROF_END ("display_cfg_hdr", "pktlib")
   endtask : display_cfg_hdr // }
 
   // This task displays all the feilds of individual hdrs used
   task display_hdr (int    mode               = DISPLAY,
                     string path_name          = ""); // {
+    `PROF_BEGIN
+    if (~dsp_ok ())
+    begin // {
+        `PROF_END ("display_hdr", "pktlib")
+        return;
+    end // }
     hdis  = new (path_name);
     this.first_hdr.display_hdr (hdis, this.first_hdr, mode);
     $display("");
+    `PROF_END ("display_hdr", "pktlib")
   endtask : display_hdr // }
 
   // This task display entire pkt
@@ -259,6 +1251,14 @@ class pktlib_main_class extends pktlib_object_class; // {
                     string    hname       = "pkt_lib",
                     string    usr_comment = "NO",
                     int       mode        = DISPLAY); // {
+    `PROF_BEGIN
+    if (~dsp_ok ())
+    begin // {
+        pkt_modified = 1'b0;
+        org_pkt.delete();
+        `PROF_END ("display_pkt", "pktlib")
+        return;
+    end // }
     hdis = new (path_name);
     if (pkt_modified)
     begin // {
@@ -271,6 +1271,7 @@ class pktlib_main_class extends pktlib_object_class; // {
     end // }
     else
         hdis.display_array8 (pkt, hname, usr_comment, mode);
+    `PROF_END ("display_pkt", "pktlib")
   endtask : display_pkt // }
 
  // This task displays entire pkt with hdrs
@@ -279,6 +1280,8 @@ class pktlib_main_class extends pktlib_object_class; // {
                        string    hname       = "pkt_lib",
                        string    usr_comment = "NO",
                        int       mode        = DISPLAY); // {
+    if (~dsp_ok ())
+        return;
     display_cfg_hdr (mode);
     display_hdr (mode, path_name);
     display_pkt (pkt, path_name, hname, usr_comment, mode);
@@ -288,13 +1291,17 @@ class pktlib_main_class extends pktlib_object_class; // {
                         ref   int               err,
                         input int               mode = COMPARE); // {
     bit display_on;
-    display_cfg_hdr         (NO_DISPLAY);
-    cmp_cls.display_cfg_hdr (NO_DISPLAY);
     if ((mode == NO_DISPLAY) | (mode == COMPARE_NO_DISPLAY))
         display_on = 1'b0;
     else
         display_on = 1'b1;
-    if (cfg_hdr_list != cmp_cls.cfg_hdr_list)
+    // cfg_hdr_list strings are built only when displayed
+    if (display_on)
+    begin // {
+        display_cfg_hdr         (NO_DISPLAY);
+        cmp_cls.display_cfg_hdr (NO_DISPLAY);
+    end // }
+    if (hdr_sig != cmp_cls.hdr_sig)
     begin // {
         err++;
         if (display_on)
@@ -308,16 +1315,155 @@ class pktlib_main_class extends pktlib_object_class; // {
   task compare_hdr (      pktlib_main_class cmp_cls,
                     ref   int               err,
                     input int               mode = COMPARE,
-                    input string            path_name          = ""); // {
+                    input string            path_name          = "",
+                    input bit               dsp_chk_done       = 1'b0); // {
+    `PROF_BEGIN
     int cfg_err;
+    // display policy, compare silently and display only if it asks for it.
+    // dsp_chk_done is set once policy is checked, so the displaying compare
+    // does not check it again
+    if ((mode != COMPARE_NO_DISPLAY) & ~dsp_chk_done & ~dsp_ok ())
+    begin // {
+        cfg_err = 0;
+        compare_hdr (cmp_cls, cfg_err, COMPARE_NO_DISPLAY, path_name);
+        if ((cfg_err > 0) & dsp_ok (1'b1))
+            compare_hdr (cmp_cls, cfg_err, mode, path_name, 1'b1);
+        if (cfg_err > 0)
+            err++;
+        `PROF_END ("compare_hdr", "pktlib")
+        return;
+    end // }
     hdis    = new (path_name);
     cfg_err = 0;
     compare_cfg_hdr (cmp_cls, cfg_err, mode);
     this.first_hdr.display_hdr (hdis, cmp_cls.first_hdr, mode);
     if ((hdis.err + cfg_err) > 0)
         err++;
+    `PROF_END ("compare_hdr", "pktlib")
   endtask : compare_hdr // }
 
+  // This task compares pkt of this and cmp_cls (both packed or unpacked)
+  // field by field and returns only the mismatching fields in diff_q. Same
+  // pkts cost one array compare, field maps are built only on a mismatch
+  // and no text is formatted (see diff_to_string)
+  task diff_hdr (      pktlib_main_class cmp_cls,
+                 ref   pktlib_diff_t     diff_q [$]); // {
+    pktlib_diff_t d;
+    hdr_class     h, c, hdr_nm [string];
+    string        key;
+    int           fld_id, off, sz, c_off, c_sz, n_hdr;
+    diff_q = {};
+    if ((pkt.size == cmp_cls.pkt.size) && (pkt == cmp_cls.pkt))
+        return;
+    // different hdr stacks, only first differing hdr is reported
+    if (hdr_sig != cmp_cls.hdr_sig)
+    begin // {
+        n_hdr = first_hdr.hdr_stk.all_hdr.size;
+        if (cmp_cls.first_hdr.hdr_stk.all_hdr.size > n_hdr)
+            n_hdr = cmp_cls.first_hdr.hdr_stk.all_hdr.size;
+        for (int i = 0; i < n_hdr; i++)
+        begin // {
+            h = (i < first_hdr.hdr_stk.all_hdr.size)         ? first_hdr.hdr_stk.all_hdr[i]         : hdr_db[EOH_HID][0];
+            c = (i < cmp_cls.first_hdr.hdr_stk.all_hdr.size) ? cmp_cls.first_hdr.hdr_stk.all_hdr[i] : hdr_db[EOH_HID][0];
+            if ((h.hid != c.hid) | (h.inst_no != c.inst_no))
+            begin // {
+                d = '{h.hid, h.inst_no, -1, h.start_off*8, 0, h.hid, c.hid};
+                diff_q.push_back (d);
+                return;
+            end // }
+        end // }
+    end // }
+    if (~fld_map_vld)
+        build_fld_map ();
+    if (~cmp_cls.fld_map_vld)
+        cmp_cls.build_fld_map ();
+    foreach (first_hdr.hdr_stk.all_hdr[ls])
+        hdr_nm [first_hdr.hdr_stk.all_hdr[ls].hdr_name] = first_hdr.hdr_stk.all_hdr[ls];
+    fld_id = 0;
+    foreach (hfld.fld_q[ls])
+    begin // {
+        if ((ls > 0) && (hfld.fld_hdr[ls] != hfld.fld_hdr[ls-1]))
+            fld_id = 0;
+        else if (ls > 0)
+            fld_id++;
+        if (~hdr_nm.exists (hfld.fld_hdr[ls]))
+            continue;
+        h     = hdr_nm [hfld.fld_hdr[ls]];
+        key   = hfld.fld_q[ls];
+        off   = hfld.fld_off [key];
+        sz    = hfld.fld_sz  [key];
+        c_off = cmp_cls.hfld.fld_off.exists (key) ? cmp_cls.hfld.fld_off [key] : 0;
+        c_sz  = cmp_cls.hfld.fld_sz.exists  (key) ? cmp_cls.hfld.fld_sz  [key] : 0;
+        if (sz != c_sz)
+        begin // {
+            d = '{h.hid, h.inst_no, fld_id, off, 0, sz/8, c_sz/8};
+            diff_q.push_back (d);
+        end // }
+        else if (sz <= `VEC_SZ)
+        begin // {
+            d = '{h.hid, h.inst_no, fld_id, off, sz, get_bits (pkt, off, sz), get_bits (cmp_cls.pkt, c_off, sz)};
+            if (d.exp != d.act)
+                diff_q.push_back (d);
+        end // }
+        else
+        begin // {
+            // long arrays (payload) report first differing byte
+            for (int i = 0; i < sz/8; i++)
+            begin // {
+                d = '{h.hid, h.inst_no, fld_id, off + i*8, 8, get_bits (pkt, off + i*8, 8), get_bits (cmp_cls.pkt, c_off + i*8, 8)};
+                if (d.exp != d.act)
+                begin // {
+                    diff_q.push_back (d);
+                    break;
+                end // }
+            end // }
+        end // }
+    end // }
+  endtask : diff_hdr // }
+
+  // This function returns sz bits of pkt starting at bit offset off
+  function bit [`VEC_SZ-1:0] get_bits (ref   bit [7:0] p [],
+                                       input int       off,
+                                       input int       sz); // {
+    get_bits = 0;
+    for (int i = 0; i < sz; i++)
+    begin // {
+        if (((off + i)/8) >= p.size)
+            break;
+        get_bits [sz - 1 - i] = p [(off + i)/8][7 - ((off + i) % 8)];
+    end // }
+  endfunction : get_bits // }
+
+  // This function formats one diff_hdr entry, uses field map of this pktlib
+  function string diff_to_string (pktlib_diff_t d); // {
+    hdr_class h;
+    string    fld_name;
+    int       id;
+    h = hdr_db[d.hid][d.inst_no];
+    if (d.fld_id == -1)
+    begin // {
+        $sformat (diff_to_string, "%0s : hdr mismatch, hid %0d != %0d", h.hdr_name, d.exp, d.act);
+        return diff_to_string;
+    end // }
+    $sformat (fld_name, "fld%0d", d.fld_id);
+    id       = 0;
+    foreach (hfld.fld_hdr[ls])
+    begin // {
+        if (hfld.fld_hdr[ls] != h.hdr_name)
+            continue;
+        if (id == d.fld_id)
+        begin // {
+            fld_name = hfld.fld_q[ls];
+            break;
+        end // }
+        id++;
+    end // }
+    if (d.fld_sz == 0)
+        $sformat (diff_to_string, "%0s : len %0d != %0d bytes", fld_name, d.exp, d.act);
+    else
+        $sformat (diff_to_string, "%0s : [%0d +: %0d] 'h%0x != 'h%0x", fld_name, d.fld_off, d.fld_sz, d.exp, d.act);
+  endfunction : diff_to_string // }
+
  // This task compare pkts and all the feilds of individual hdrs with other class
   task compare_pkt (      bit [7:0] p1 [],
                           bit [7:0] p2 [],
@@ -329,21 +1475,39 @@ class pktlib_main_class extends pktlib_object_class; // {
                     input string    hname     = "pkt_lib",
                     input string    cmp_type  = "Pkt",
                     input bit       crc_psnt  = 1'b1); // {
+    `PROF_BEGIN
     pktlib_class p_cls;
     int          cfg_err;
+    bit          is_err;
     cfg_err = 0;
+    // display policy is checked before any formatting
+    is_err  = (p1.size != p2.size) || (p1 != p2);
+    if ((mode != COMPARE_NO_DISPLAY) & ~dsp_ok (is_err))
+        mode = COMPARE_NO_DISPLAY;
     hdis = new (path_name);
     hdis.compare_array8 (p1, p2, cfg_err, mode, hname,, cmp_type);
+    `ifdef PKTLIB_DPI_TRACE
+    if (pktlib_display_class::trc_hdl >= 0)
+        trace_pkt (p2, (cfg_err > 0) ? TRC_CMP_FAIL : TRC_CMP_PASS);
+    `endif
     if (cfg_err > 0)
     begin // {
         err++;
+        // pkts before the miscompare, from flight recorder
+        if ((pktlib_display_class::rec_depth > 0) & dsp_ok (1'b1))
+            dump_history (pnum);
+        pktlib_display_class::rec_busy = 1'b1;
         p_cls = new ();
         p_cls.toh.cal_n_add_crc = crc_psnt;
         unpack_hdr       (p1, SMART_UNPACK, hdr, p_format);
         p_cls.unpack_hdr (p2, SMART_UNPACK, hdr, p_format);
-        compare_hdr      (p_cls, cfg_err, mode, path_name);
+        pktlib_display_class::rec_busy = 1'b0;
+        if (mode != COMPARE_NO_DISPLAY)
+            compare_hdr  (p_cls, cfg_err, mode, path_name, 1'b1);
     end // }
-    $display("");
+    if (mode != COMPARE_NO_DISPLAY)
+        $display("");
+    `PROF_END ("compare_pkt", "pktlib")
   endtask : compare_pkt // }
 
 endclass : pktlib_main_class // }
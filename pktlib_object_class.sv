@@ -17,9 +17,88 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 virtual class pktlib_object_class; // {
 
+  // ~~~~~~~~~~ Allocation accounting (off by default) ~~~~~~~~~~
+  // SV has no destructor, so objects are counted when newed; live objects
+  // can't be seen. Enable with +pktlib_obj_acct or acct_en = 1
+  static bit     acct_en        = $test$plusargs ("pktlib_obj_acct");
+  static longint acct_cnt   [string];      // objects newed per class
+  static longint acct_bytes [string];      // estimated bytes newed per class
+  static longint acct_pkt_cnt   = 0;       // objects newed since last pkt
+  static longint acct_pkt_bytes = 0;
+  static longint acct_hwm_cnt   = 0;       // most objects newed for one pkt
+  static longint acct_hwm_bytes = 0;
+  static longint acct_num_pkt   = 0;       // pkts packed/unpacked
+
   // This function news all the hdrs
   function new (); // {
+    if (acct_en)
+        acct_add (obj_type (), obj_bytes ());
   endfunction : new // }
 
-endclass : pktlib_object_class // }
+  // class name used by accounting
+  virtual function string obj_type (); // {
+    return "pktlib_object_class";
+  endfunction : obj_type // }
+
+  // estimated bytes of one object, without dynamic arrays
+  virtual function int obj_bytes (); // {
+    return 64;
+  endfunction : obj_bytes // }
+
+  // function to count num objects of class name
+  static function void acct_add (string name,
+                                 int    bytes,
+                                 int    num = 1); // {
+    if (!acct_cnt.exists (name))
+    begin // {
+        acct_cnt   [name] = 0;
+        acct_bytes [name] = 0;
+    end // }
+    acct_cnt   [name] += num;
+    acct_bytes [name] += num * bytes;
+    acct_pkt_cnt      += num;
+    acct_pkt_bytes    += num * bytes;
+  endfunction : acct_add // }
 
+  // function to move one object from class frm to class to, used once an
+  // object knows its name (for E.g. hdrs after hdr_name is set)
+  static function void acct_move (string frm,
+                                  string to,
+                                  int    bytes); // {
+    if (!acct_cnt.exists (frm))
+        return;
+    acct_cnt   [frm] -= 1;
+    acct_bytes [frm] -= bytes;
+    if (acct_cnt [frm] == 0)
+    begin // {
+        acct_cnt.delete   (frm);
+        acct_bytes.delete (frm);
+    end // }
+    acct_add (to, bytes);
+    acct_pkt_cnt   -= 1;
+    acct_pkt_bytes -= bytes;
+  endfunction : acct_move // }
+
+  // function to close per pkt window and update high water mark
+  static function void acct_pkt (); // {
+    acct_num_pkt++;
+    if (acct_pkt_cnt > acct_hwm_cnt)
+        acct_hwm_cnt = acct_pkt_cnt;
+    if (acct_pkt_bytes > acct_hwm_bytes)
+        acct_hwm_bytes = acct_pkt_bytes;
+    acct_pkt_cnt   = 0;
+    acct_pkt_bytes = 0;
+  endfunction : acct_pkt // }
+
+  // function to clear all the counts
+  static function void acct_clr (); // {
+    acct_cnt.delete ();
+    acct_bytes.delete ();
+    acct_pkt_cnt   = 0;
+    acct_pkt_bytes = 0;
+    acct_hwm_cnt   = 0;
+    acct_hwm_bytes = 0;
+    acct_num_pkt   = 0;
+  endfunction : acct_clr // }
+
+endclass : pktlib_object_class // }
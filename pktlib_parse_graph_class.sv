@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+//  class for custom parse graph transitions (used by SMART_UNPACK)
+//  Maps (cur hid, selector, value) -> nxt hid. Transitions added here win
+//  over the per object selectors (ex: vxlan_udp_dst_prt), which hold the
+//  default parse graph from the hdr_db defines.
+// ----------------------------------------------------------------------
+
+class pktlib_parse_graph_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  static int  cust_tbl  [bit [63:0]];     // {cur hid, sel, value} -> nxt hid, cur hid 'hffff for all
+
+  // ~~~~~~~~~~ Function to add/override a transition ~~~~~~~~~~
+  // cur_hid == -1 applies after any hdr, else only after cur_hid
+  static function void add_transition (int        sel,
+                                       bit [31:0] value,
+                                       int        nxt_hid,
+                                       int        cur_hid = -1); // {
+    if (~(sel inside {SEL_ETYPE, SEL_PROT, SEL_UDP_DST_PRT, SEL_TCP_DST_PRT}))
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : add_transition : Unknown selector %0d", $time, sel);
+        return;
+    end // }
+    cust_tbl[{cur_hid[15:0], sel[15:0], value}] = nxt_hid;
+  endfunction : add_transition // }
+
+  // ~~~~~~~~~~ Function to get nxt hid for (cur_hid, sel, value) ~~~~~~~~~~
+  // returns -1 if no transition is added, caller then uses its selectors
+  static function int get_nxt_hid (int        cur_hid,
+                                   int        sel,
+                                   bit [31:0] value); // {
+    get_nxt_hid = -1;
+    if (cust_tbl.num () == 0)
+        return get_nxt_hid;
+    if (cust_tbl.exists ({cur_hid[15:0], sel[15:0], value}))
+        get_nxt_hid = cust_tbl[{cur_hid[15:0], sel[15:0], value}];
+    else if (cust_tbl.exists ({16'hffff, sel[15:0], value}))
+        get_nxt_hid = cust_tbl[{16'hffff, sel[15:0], value}];
+  endfunction : get_nxt_hid // }
+
+  // ~~~~~~~~~~ Function to drop all custom transitions ~~~~~~~~~~
+  static function void reset_tbl (); // {
+    cust_tbl.delete ();
+  endfunction : reset_tbl // }
+
+endclass : pktlib_parse_graph_class // }
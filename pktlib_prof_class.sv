@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+//  class to profile wall clock time of pktlib stages (sim time doesn't
+//  advance in pack/unpack/compare). Stages are opened/closed by
+//  PROF_BEGIN/PROF_END, time of nested stages is kept out of self time.
+//  Only compiled with PKTLIB_DPI_PROF (hdr_db/include/prof/prof_dpi.c).
+//  Enable with +pktlib_prof or pktlib_prof_class::prf_en = 1.
+// ----------------------------------------------------------------------
+
+class pktlib_prof_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  static bit             prf_en   = $test$plusargs ("pktlib_prof");
+  static longint         prf_t0   [$];                // start time of open stages
+  static longint         prf_chld [$];                // time spent in nested stages of open stages
+  static longint         prf_cnt  [string][string];   // stage -> name -> calls
+  static longint         prf_tot  [string][string];   // time incl. nested stages (ns)
+  static longint         prf_self [string][string];   // time excl. nested stages (ns)
+  static longint         prf_max  [string][string];   // max time of one call (ns)
+  static longint         prf_dpi  [string][string];   // DPI crossings (timed DPI calls)
+  static longint         prf_clk  = 0;                // DPI crossings of clock itself
+
+  // function to open a stage, returns its depth (-1 if profiling is off)
+  static function int push (); // {
+    if (~prf_en)
+        return -1;
+    prf_chld.push_back (0);
+    prf_t0.push_back (pv_prof_now ());
+    prf_clk++;
+    return (prf_t0.size - 1);
+  endfunction : push // }
+
+  // function to close stage opened at depth d. Stages left open above d
+  // (by a randomize that failed) are dropped
+  static function void pop (string stage,
+                            string name,
+                            int    d,
+                            int    dpi = 0); // {
+    longint dt;
+    if ((d < 0) | (d >= prf_t0.size))
+        return;
+    dt = pv_prof_now () - prf_t0[d];
+    prf_clk++;
+    if (!prf_cnt.exists (stage) || !prf_cnt[stage].exists (name))
+    begin // {
+        prf_cnt  [stage][name] = 0;
+        prf_tot  [stage][name] = 0;
+        prf_self [stage][name] = 0;
+        prf_max  [stage][name] = 0;
+        prf_dpi  [stage][name] = 0;
+    end // }
+    prf_cnt  [stage][name] += 1;
+    prf_tot  [stage][name] += dt;
+    prf_self [stage][name] += dt - prf_chld[d];
+    prf_dpi  [stage][name] += dpi;
+    if (dt > prf_max [stage][name])
+        prf_max [stage][name] = dt;
+    while (prf_t0.size > d)
+    begin // {
+        void'(prf_t0.pop_back ());
+        void'(prf_chld.pop_back ());
+    end // }
+    if (d > 0)
+        prf_chld[d-1] += dt;
+  endfunction : pop // }
+
+  // function to clear all the stats
+  static function void clear (); // {
+    prf_t0.delete ();
+    prf_chld.delete ();
+    prf_cnt.delete ();
+    prf_tot.delete ();
+    prf_self.delete ();
+    prf_max.delete ();
+    prf_dpi.delete ();
+    prf_clk = 0;
+  endfunction : clear // }
+
+  // function to display stats sorted by self time (top rows only if top > 0).
+  // All the rows are also written to csv_file if given
+  static function void report (int    top      = 0,
+                               string csv_file = ""); // {
+    pktlib_prof_row_t row_q [$];
+    pktlib_prof_row_t row;
+    longint           tot_self = 0;
+    int               fd;
+    foreach (prf_cnt[stage, name])
+    begin // {
+        row.stage = stage;
+        row.name  = name;
+        row.cnt   = prf_cnt  [stage][name];
+        row.tot   = prf_tot  [stage][name];
+        row.self  = prf_self [stage][name];
+        row.max   = prf_max  [stage][name];
+        row.dpi   = prf_dpi  [stage][name];
+        row_q.push_back (row);
+        tot_self += row.self;
+    end // }
+    row_q.rsort (r) with (r.self);
+    $display ("%0t : INFO    : PROFILE   : %16s %16s %10s %12s %12s %6s %10s %10s %8s", $time,
+              "stage", "name", "calls", "self_us", "total_us", "self%", "avg_ns", "max_ns", "dpi");
+    foreach (row_q[i])
+    begin // {
+        if ((top > 0) & (i >= top))
+            break;
+        $display ("%0t : INFO    : PROFILE   : %16s %16s %10d %12.1f %12.1f %6.2f %10d %10d %8d", $time,
+                  row_q[i].stage, row_q[i].name, row_q[i].cnt, row_q[i].self/1000.0, row_q[i].tot/1000.0,
+                  (tot_self > 0) ? (100.0 * row_q[i].self / tot_self) : 0.0,
+                  row_q[i].tot / row_q[i].cnt, row_q[i].max, row_q[i].dpi);
+    end // }
+    $display ("%0t : INFO    : PROFILE   : %0d stages, %0d clock DPI crossings (profiling overhead)",
+              $time, row_q.size, prf_clk);
+    if (csv_file == "")
+        return;
+    fd = $fopen (csv_file, "w");
+    if (fd == 0)
+    begin // {
+        $display ("%0t : ERROR   : pkt_lib   : report can't open %0s", $time, csv_file);
+        return;
+    end // }
+    $fdisplay (fd, "stage,name,calls,self_ns,total_ns,max_ns,dpi");
+    foreach (row_q[i])
+        $fdisplay (fd, "%0s,%0s,%0d,%0d,%0d,%0d,%0d", row_q[i].stage, row_q[i].name, row_q[i].cnt,
+                   row_q[i].self, row_q[i].tot, row_q[i].max, row_q[i].dpi);
+    $fclose (fd);
+  endfunction : report // }
+
+endclass : pktlib_prof_class // }
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+//  class to match received pkts against expected pkts out of order.
+//  Expected pkts are indexed by flow hash (or pkt hash) per qid, so a
+//  received pkt finds its candidates with one assoc lookup. compare_pkt
+//  (unpack and diff) only runs on a true mismatch. A pkt whose key has no
+//  expected pkt (ex: corrupted ip/port) is diffed with oldest expected pkt
+//  of its qid.
+// ----------------------------------------------------------------------
+
+class pktlib_scoreboard_class; // {
+
+  // ~~~~~~~~~~ Class variables ~~~~~~~~~~
+  string             name;
+  int                key_mode;
+  bit                crc_psnt = 1'b1;                // pkts have crc, used by flow key & diff
+  int                p_format = IEEE802;
+  int                mode     = COMPARE;             // display mode of diff on mismatch
+  pktlib_class       plib;                           // used for flow key & diff
+  pktlib_sb_entry_t  exp_db [int] [bit [63:0]] [$];  // qid -> key -> expected pkts in order
+  int                num_exp, num_match, num_ooo, num_mismatch, num_unexp;
+  int                exp_seq;                        // seq of nxt expected pkt
+
+  function new (string name     = "pkt_sb",
+                int    key_mode = SB_FLOW_HASH); // {
+    this.name     = name;
+    this.key_mode = key_mode;
+    plib          = new ();
+    clear ();
+  endfunction : new // }
+
+  // function to drop all expected pkts and counters
+  function void clear (); // {
+    exp_db.delete ();
+    num_exp      = 0;
+    num_match    = 0;
+    num_ooo      = 0;
+    num_mismatch = 0;
+    num_unexp    = 0;
+    exp_seq      = 0;
+  endfunction : clear // }
+
+  // function to get FNV-1a 64 hash of pkt bytes
+  static function bit [63:0] pkt_hash (ref bit [7:0] pkt []); // {
+    pkt_hash = 64'hcbf29ce484222325;
+    foreach (pkt[i])
+        pkt_hash = (pkt_hash ^ pkt[i]) * 64'h100000001b3;
+  endfunction : pkt_hash // }
+
+  // function to get index key of pkt as per key_mode
+  function bit [63:0] get_key (ref   bit [7:0]  pkt [],
+                               input bit [63:0] p_hash); // {
+    pktlib_flow_key_t outer, inner;
+    if (key_mode == SB_PKT_HASH)
+        return p_hash;
+    plib.toh.cal_n_add_crc = crc_psnt;
+    return plib.get_flow_key (pkt, outer, inner, p_format);
+  endfunction : get_key // }
+
+  // function to add an expected pkt
+  function void add_exp (bit [7:0] pkt [],
+                         int       qid = 0); // {
+    pktlib_sb_entry_t e;
+    e.pkt      = pkt;
+    e.pkt_hash = pkt_hash (e.pkt);
+    e.seq      = exp_seq++;
+    exp_db[qid][get_key (e.pkt, e.pkt_hash)].push_back (e);
+    num_exp++;
+  endfunction : add_exp // }
+
+  // function to get key of oldest expected pkt of qid (qid must have one)
+  function bit [63:0] get_oldest_key (int qid); // {
+    int seq = -1;
+    foreach (exp_db[qid][k])
+    begin // {
+        if ((seq < 0) || (exp_db[qid][k][0].seq < seq))
+        begin // {
+            seq            = exp_db[qid][k][0].seq;
+            get_oldest_key = k;
+        end // }
+    end // }
+  endfunction : get_oldest_key // }
+
+  // task to check a received pkt. Matches oldest expected pkt of its flow
+  // first, then any expected pkt of the flow (reordered). Else oldest
+  // expected pkt of the flow (of the qid if flow has none) is diffed with
+  // compare_pkt and dropped
+  task chk_rcv (bit [7:0] pkt [],
+                int       qid = 0); // {
+    bit [63:0] p_hash, key;
+    int        err = 0;
+    p_hash = pkt_hash (pkt);
+    key    = get_key (pkt, p_hash);
+    if (~exp_db.exists (qid) || (exp_db[qid].num () == 0))
+    begin // {
+        $display ("%0t : ERROR   : %0s : Unexpected pkt on qid %0d, %0d bytes, key %h", $time, name, qid, pkt.size, key);
+        num_unexp++;
+        return;
+    end // }
+    if (~exp_db[qid].exists (key))
+    begin // {
+        $display ("%0t : ERROR   : %0s : No expected pkt on qid %0d for key %h, diff with oldest expected pkt", $time, name, qid, key);
+        key = get_oldest_key (qid);
+    end // }
+    foreach (exp_db[qid][key][i])
+    begin // {
+        if ((exp_db[qid][key][i].pkt_hash == p_hash) && (exp_db[qid][key][i].pkt == pkt))
+        begin // {
+            num_match++;
+            if (i != 0)
+                num_ooo++;
+            exp_db[qid][key].delete (i);
+            if (exp_db[qid][key].size == 0)
+                exp_db[qid].delete (key);
+            return;
+        end // }
+    end // }
+    // true mismatch
+    num_mismatch++;
+    $display ("%0t : ERROR   : %0s : Mismatch on qid %0d, key %h", $time, name, qid, key);
+    plib.compare_pkt (exp_db[qid][key][0].pkt, pkt, err, {}, p_format, mode, name, name, "Pkt", crc_psnt);
+    exp_db[qid][key].delete (0);
+    if (exp_db[qid][key].size == 0)
+        exp_db[qid].delete (key);
+  endtask : chk_rcv // }
+
+  // function to report counters and missing pkts. Returns number of errors
+  function int report (); // {
+    int num_miss = 0;
+    foreach (exp_db[q, k])
+    begin // {
+        $display ("%0t : ERROR   : %0s : %0d pkts missing on qid %0d, key %h", $time, name, exp_db[q][k].size, q, k);
+        num_miss += exp_db[q][k].size;
+    end // }
+    $display ("%0t : INFO    : %0s : Expected %0d Matched %0d (Reordered %0d) Mismatched %0d Unexpected %0d Missing %0d",
+              $time, name, num_exp, num_match, num_ooo, num_mismatch, num_unexp, num_miss);
+    return (num_mismatch + num_unexp + num_miss);
+  endfunction : report // }
+
+endclass : pktlib_scoreboard_class // }
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+//  Width specialized pack/unpack class. W is the width of the packed
+//  field vector, so each hdr moves only its own bits instead of a
+//  `VEC_SZ bit vector. Used as pktlib_vec_class #($bits(vec))::pack_bit
+// ----------------------------------------------------------------------
+
+class pktlib_vec_class #(int W = 8); // {
+
+  // this task converts W bit vector into pkt array of 8 bit
+  static task pack_bit (ref   bit [7:0]   pkt [],         // Output array
+                        input bit [W-1:0] bit_vec,        // bit vector to pack 
+                        ref   int         start_offset,   // starting offset in bits
+                        input int         length = W,     // how much data to pack 
+                        input bit         no_icr = 1'b0); // don't increment start_offset if 1 {
+    bit [7:0] hold_reg;
+    int       i;
+    for (i = start_offset/8; i < (start_offset+length)/8; i++)
+    begin // {
+        hold_reg = bit_vec  >> (length - (i - start_offset/8 + 1) * 8);
+        pkt[i]  |= hold_reg << (start_offset % 8);
+        if (start_offset % 8 != 0)
+            pkt[i+1] |= hold_reg >> (8 - start_offset % 8);
+    end // }
+    if (i*8 < (start_offset + length))
+    begin // {
+        hold_reg = bit_vec;
+        pkt[i]  |= hold_reg << (start_offset % 8);
+    end // }
+    if (~no_icr)
+        start_offset += length;
+  endtask : pack_bit // }
+
+  // this tasks converts 8 byte array into W bit unpack vector
+  static task unpack_array (const ref bit [7:0]   array_8 [],
+                            ref       bit [W-1:0] unpack_vec,
+                            ref       int         start_offset,   // starting offset in bytes
+                            input     int         length = W/8,   // how much data to unpack 
+                            input     bit         no_icr = 1'b0); // don't increment start_offset if 1 {
+    unpack_vec = unpack_vec << (length*8);
+    for (int i = 0; i < length; i++)
+    begin // {
+        if ((start_offset + i) < array_8.size)
+            unpack_vec[(length - 1 - i)*8 +: 8] = array_8[start_offset + i];
+    end // }
+    if (~no_icr)
+        start_offset += length; 
+  endtask : unpack_array // }
+
+  // this task writes W bit vector directly at pkt[start_offset], W is multiple of 8
+  static task pack_8 (ref   bit [7:0]   pkt [],         // Output array
+                      input bit [W-1:0] bit_vec,        // bit vector to pack 
+                      ref   int         start_offset);  // starting offset in bytes {
+    for (int i = 0; i < W/8; i++)
+        pkt[start_offset + i] = bit_vec[W - 8*(i+1) +: 8];
+    start_offset += W/8;
+  endtask : pack_8 // }
+
+  // this function reads W bits at pkt[start_offset] and increments start_offset by icr_len
+  static function bit [W-1:0] unpack_8 (const ref bit [7:0] pkt [],
+                                        ref       int       start_offset,   // starting offset in bytes
+                                        input     int       icr_len = W/8); // how much to increment start_offset {
+    unpack_8 = 0;
+    for (int i = 0; i < W/8; i++)
+    begin // {
+        if ((start_offset + i) < pkt.size)
+            unpack_8[W - 8*(i+1) +: 8] = pkt[start_offset + i];
+    end // }
+    start_offset += icr_len;
+  endfunction : unpack_8 // }
+
+endclass : pktlib_vec_class // }
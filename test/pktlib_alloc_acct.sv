@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies allocation accounting. A new pktlib is built per
+// pkt, so every pkt must see objects of one pktlib in its window.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 10
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p;
+  bit [7:0]      p_pkt []; 
+  int            i, err;
+
+  initial
+  begin // {
+    pktlib_object_class::acct_en = 1'b1;
+    pktlib_object_class::acct_clr ();
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        p = new();
+        p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+        $display("%0t : INFO    : TEST      : Alloc Acct Pkt %0d", $time, i+1);
+    end // }
+    if (pktlib_object_class::acct_cnt ["pktlib_main_class"] != `NUM_PKTS)
+    begin // {
+        $display("%0t : ERROR   : TEST      : %0d pktlibs counted, expected %0d", $time, 
+                 pktlib_object_class::acct_cnt ["pktlib_main_class"], `NUM_PKTS);
+        err++;
+    end // }
+    if (pktlib_object_class::acct_cnt ["eth"] != `NUM_PKTS * `MAX_NUM_INSTS)
+    begin // {
+        $display("%0t : ERROR   : TEST      : %0d eth hdrs counted, expected %0d", $time, 
+                 pktlib_object_class::acct_cnt ["eth"], `NUM_PKTS * `MAX_NUM_INSTS);
+        err++;
+    end // }
+    if (pktlib_object_class::acct_cnt.exists ("hdr_class"))
+    begin // {
+        $display("%0t : ERROR   : TEST      : %0d hdrs not counted by name", $time, pktlib_object_class::acct_cnt ["hdr_class"]);
+        err++;
+    end // }
+    if ((pktlib_object_class::acct_num_pkt != `NUM_PKTS) | (pktlib_object_class::acct_hwm_cnt == 0))
+    begin // {
+        $display("%0t : ERROR   : TEST      : %0d pkts counted, high water mark %0d", $time, 
+                 pktlib_object_class::acct_num_pkt, pktlib_object_class::acct_hwm_cnt);
+        err++;
+    end // }
+    pktlib_main_class::report_alloc ();
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Alloc Acct Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Alloc Acct Checks Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,213 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test benchmarks pkts per second (wall clock, pv_prof_now DPI timer)
+// for each of the 20 cfg_hdr shapes of pktlib_test.sv and plen of 64B to
+// 9KB : randomize, pack, unpack (DUMB and SMART), cpy_hdr (LITE and DEEP)
+// and compare_pkt. GCM encrypt/decrypt and pcap dump/read (with
+// +define+PKTLIB_BENCH_PCAP) are run on pkts of shape 0.
+// Results go to +csv=<file> (log/pktlib_bench.csv), +iter=<n> sets pkts
+// per row (100). Run with scripts/pktlib_bench_run pktlib_bench
+// ----------------------------------------------------------------------
+
+`define NUM_SHAPES 20
+
+`include "../hdr_db/include/gcm-aes/sv-file/gcm_dpi.sv"
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+  `ifndef PKTLIB_DPI_PROF
+  `include "prof_dpi.sv"
+  `endif
+  `ifdef PKTLIB_BENCH_PCAP
+  `include "../hdr_db/include/pcap/pcap_dpi.sv"
+  `endif
+
+  // local defines
+  pktlib_class   p, u, c;
+  bit [7:0]      p_pkt [], u_pkt [], o_pkt [];
+  int            bench_sz [] = '{64, 512, 1518, 9000};
+  int            num_iter, fd, shape, sz, i, err, p_format, out_plen, phandle, pkt_len;
+  longint        t0;
+  bit [63:0]     sm_time;
+  string         csv_file;
+
+  // configure cfg_hdr shape s of pktlib_test.sv
+  function automatic void cfg_shape (pktlib_class p, int s); // {
+    case (s) // {
+        0  : p.cfg_hdr ('{p.eth[0], p.ipv4[0],  p.gre[0],   p.mpls[0], p.ipv6[0],  p.tcp[0],   p.data[0]});
+        1  : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.vntag[0], p.ipv4[0], p.udp[0],   p.ptp[0],   p.data[0]});
+        2  : p.cfg_hdr ('{p.eth[0], p.ipv4[0],  p.gre[0],   p.eth[1],  p.itag[0],  p.eth[2],   p.data[0]});
+        3  : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.mpls[0],  p.ipv4[0], p.udp[0],   p.ntp[0],   p.data[0]});
+        4  : p.cfg_hdr ('{p.eth[0], p.mpls[0],  p.ipv4[0],  p.udp[0],  p.lisp[0],  p.ipv4[1],  p.icmp[0], p.data[0]});
+        5  : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.trill[0], p.eth[1],  p.dot1q[1], p.ipv6[0],  p.gre[0],  p.data[0]});
+        6  : p.cfg_hdr ('{p.eth[0], p.mmpls[0], p.eth[1],   p.ipv6[0], p.udp[0],   p.lisp[0],  p.ipv6[1], p.icmpv6[0], p.data[0]});
+        7  : p.cfg_hdr ('{p.eth[0], p.etag[0],  p.mmpls[0], p.ipv6[0], p.udp[0],   p.otv[0],   p.eth[1],  p.rarp[0],   p.data[0]});
+        8  : p.cfg_hdr ('{p.eth[0], p.alt1q[0], p.trill[0], p.eth[1],  p.alt1q[1], p.ipv4[0],  p.ipv6[0], p.igmp[0],   p.data[0]});
+        9  : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.mpls[0],  p.ipv6[0], p.udp[0],   p.vxlan[0], p.eth[1],  p.dot1q[1],  p.arp[0],  p.data[0]});
+        10 : p.cfg_hdr ('{p.eth[0], p.itag[0],  p.eth[1],   p.ipv4[0], p.tcp[0],   p.stt[0],   p.eth[2],  p.ipv4[1],   p.tcp[1],  p.data[0]});
+        11 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.dot1q[1], p.ipv4[0], p.tcp[0],   p.stt[0],   p.eth[1],  p.ipv6[0],   p.ipv4[1], p.igmp[0], p.data[0]});
+        12 : p.cfg_hdr ('{p.eth[0], p.roce[0],  p.grh[0],   p.bth[0], p.data[0]});
+        13 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.fcoe[0],  p.fc[0], p.data[0]});
+        14 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.cntag[0], p.cnm[0], p.data[0]});
+        15 : p.cfg_hdr ('{p.eth[0], p.ipv6[0],  p.ipv6_hopopt[0], p.ipv6_opts[0], p.ipv6_rout[0], p.ipv6_frag[0], p.ipv6_opts[1], p.igmp[0], p.data[0]});
+        16 : p.cfg_hdr ('{p.eth[0], p.macsec[0], p.ipv6[0],  p.ipv6_hopopt[0], p.ipv6_opts[0], p.ipv6_rout[0], p.ipv6_frag[0], p.ipv6_opts[1], p.igmp[0], p.data[0]});
+        17 : p.cfg_hdr ('{p.fc[0], p.data[0]});
+        18 : p.cfg_hdr ('{p.dphy[0], p.data[0]});
+        19 : p.cfg_hdr ('{p.dphy[0]});
+    endcase // }
+  endfunction : cfg_shape // }
+
+  // write one result row
+  function automatic void add_row (int     shape,
+                                   int     plen,
+                                   string  op,
+                                   longint ns); // {
+    real pps;
+    pps = (ns > 0) ? (num_iter * 1.0e9 / ns) : 0.0;
+    $fdisplay (fd, "%0d,%0d,%0s,%0d,%0d,%0.1f", shape, plen, op, num_iter, ns, pps);
+    $display ("%0t : INFO    : TEST      : Shape %2d plen %5d %14s %12.1f pkts/s", $time, shape, plen, op, pps);
+  endfunction : add_row // }
+
+  initial
+  begin // {
+    num_iter = 100;
+    csv_file = "log/pktlib_bench.csv";
+    void'($value$plusargs ("iter=%d", num_iter));
+    void'($value$plusargs ("csv=%s", csv_file));
+    fd = $fopen (csv_file, "w");
+    if (fd == 0)
+    begin // {
+        $display("%0t : ERROR   : TEST      : Can't open %0s", $time, csv_file);
+        $finish ();
+    end // }
+    $fdisplay (fd, "shape,plen,op,pkts,ns,pkts_per_sec");
+    pktlib_display_class::set_dsp_policy (DSP_NONE);
+    `ifdef PKTLIB_BENCH_PCAP
+    pv_register ();
+    `endif
+    for (shape = 0; shape < `NUM_SHAPES; shape++)
+    begin // {
+        p_format = (shape == 17) ? FC : ((shape > 17) ? MIPI_CSI2_DPHY : IEEE802);
+        foreach (bench_sz[s])
+        begin // {
+            // new pktlib with plen of bench_sz, if shape can't take it use
+            // any plen upto bench_sz
+            p = new();
+            cfg_shape (p, shape);
+            p.toh.max_plen = bench_sz[s];
+            p.toh.min_plen = bench_sz[s];
+            if (!p.randomize ())
+            begin // {
+                p.toh.min_plen = 4;
+                if (!p.randomize ())
+                begin // {
+                    $display("%0t : INFO    : TEST      : Shape %0d can't randomize for plen %0d, skipped", $time, shape, bench_sz[s]);
+                    continue;
+                end // }
+            end // }
+            p.pack_hdr (p_pkt);
+            sz = p_pkt.size;
+
+            // randomize
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                void'(p.randomize ());
+            add_row (shape, sz, "randomize", pv_prof_now () - t0);
+
+            // pack
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                p.pack_hdr (p_pkt);
+            add_row (shape, sz, "pack", pv_prof_now () - t0);
+            sz = p_pkt.size;
+
+            // unpack with cfg_hdr of p
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                p.unpack_hdr (p_pkt, DUMB_UNPACK);
+            add_row (shape, sz, "unpack_dumb", pv_prof_now () - t0);
+
+            // unpack without cfg_hdr
+            u = new();
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                u.unpack_hdr (p_pkt, SMART_UNPACK,, p_format);
+            add_row (shape, sz, "unpack_smart", pv_prof_now () - t0);
+
+            // copy
+            c = new();
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                c.cpy_hdr (p, COPY_LITE);
+            add_row (shape, sz, "cpy_lite", pv_prof_now () - t0);
+            c = new();
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                c.cpy_hdr (p, COPY_DEEP);
+            add_row (shape, sz, "cpy_deep", pv_prof_now () - t0);
+
+            // compare (both unpacks and diff)
+            u_pkt = new [p_pkt.size] (p_pkt);
+            err   = 0;
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                u.compare_pkt (p_pkt, u_pkt, err,, p_format, COMPARE_NO_DISPLAY);
+            add_row (shape, sz, "compare", pv_prof_now () - t0);
+            if (err)
+                $display("%0t : ERROR   : TEST      : Shape %0d plen %0d compare of same pkt failed", $time, shape, sz);
+
+            if (shape != 0)
+                continue;
+
+            `ifndef NO_PROCESS_AE
+            // gcm encrypt/decrypt (20B auth only, rest encrypted)
+            o_pkt = new [sz + 16];
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                gcm_crypt ({4{32'h0badcafe}}, 64'h1, 32'h1, 0, 0, 20, 1, sz - 20, p_pkt, o_pkt, out_plen);
+            add_row (shape, sz, "gcm_encrypt", pv_prof_now () - t0);
+            u_pkt = new [sz] (o_pkt);
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                gcm_crypt ({4{32'h0badcafe}}, 64'h1, 32'h1, 0, 0, 20, 0, sz - 20, u_pkt, o_pkt, out_plen);
+            add_row (shape, sz, "gcm_decrypt", pv_prof_now () - t0);
+            `endif
+
+            `ifdef PKTLIB_BENCH_PCAP
+            // pcap dump/read
+            pv_open (phandle, "pcap_log/pktlib_bench.pcap", 0);
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                pv_dump_pkt (phandle, p_pkt.size, p_pkt, $time);
+            pv_shutdown (phandle);
+            add_row (shape, sz, "pcap_dump", pv_prof_now () - t0);
+            pv_open (phandle, "pcap_log/pktlib_bench.pcap", 1);
+            u_pkt = new [`MAX_PLEN + 1];
+            t0 = pv_prof_now ();
+            for (i = 0; i < num_iter; i++)
+                pv_get_pkt (phandle, pkt_len, u_pkt, sm_time);
+            add_row (shape, sz, "pcap_read", pv_prof_now () - t0);
+            pv_shutdown (phandle);
+            `endif
+        end // }
+    end // }
+    $fclose (fd);
+    $display("%0t : INFO    : TEST      : Benchmark results in %0s", $time, csv_file);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies clone (cpy_hdr COPY_DEEP). Each pkt is randomized and
+// packed, cloned and repacked from the clone. Clone hdrs must not be
+// shared with the original pktlib.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, c;
+  bit [7:0]      p_pkt [], c_pkt []; 
+  bit [7:0]      ttl;
+  int            i, err;
+
+  initial
+  begin // {
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%4) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[0], p.tcp[0], p.data[0]});
+            3 : p.cfg_hdr ('{p.eth[0], p.mpls[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // clone and repack from clone
+        p.clone (c);
+        c.pack_hdr (c_pkt);
+        if (c_pkt != p_pkt)
+        begin // {
+            $display("%0t : ERROR   : TEST      : Clone pkt mismatch for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+
+        // clone hdrs are its own, changing them leaves original as is
+        foreach (c.first_hdr.hdr_stk.all_hdr[ls])
+        begin // {
+            if ((c.first_hdr.hdr_stk.all_hdr[ls] == p.first_hdr.hdr_stk.all_hdr[ls]) |
+                (c.first_hdr.hdr_stk.all_hdr[ls].plib != c))
+            begin // {
+                $display("%0t : ERROR   : TEST      : Clone shares %0s for Pkt %0d", $time, c.first_hdr.hdr_stk.all_hdr[ls].hdr_name, i+1);
+                err++;
+            end // }
+        end // }
+        ttl = p.ipv4[0].ttl;
+        c.ipv4[0].ttl = ~ttl;
+        if (p.ipv4[0].ttl != ttl)
+        begin // {
+            $display("%0t : ERROR   : TEST      : Clone change seen in original for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Clone Pkt %0d", $time, i+1);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Clone Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Clone Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
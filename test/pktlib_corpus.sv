@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test writes a pkt corpus for a cfg_hdr and seed, then replays it
+// in a new pktlib. Replayed pkts and their unpacked hdrs must be same as
+// generated ones. Needs +define+PKTLIB_DPI_TRACE and trace_dpi.c
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 50
+`define SEED     64'h5eed
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u;
+  bit [7:0]      p_pkt [], u_pkt []; 
+  bit [7:0]      gen_q [$][]; 
+  int            i, err, num_hit;
+  bit            hit;
+
+  initial
+  begin // {
+    // write corpus in a clean dir
+    void'($system ("rm -rf log/corpus_test; mkdir -p log/corpus_test"));
+    p = new();
+    p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[1], p.tcp[0], p.data[0]});
+    p.toh.max_plen = 1500;
+    p.toh.min_plen = 64;
+    if (p.corpus_open ("log/corpus_test", `SEED, "test"))
+    begin // {
+        $display("%0t : ERROR   : TEST      : Corpus replayed before it was written", $time);
+        err++;
+    end // }
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        p.corpus_get (p_pkt, hit);
+        if (hit)
+            err++;
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+        p.corpus_put ();
+        gen_q.push_back (p_pkt);
+    end // }
+    p.corpus_close ();
+
+    // replay corpus in a new pktlib with same cfg
+    u = new();
+    u.cfg_hdr ('{u.eth[0], u.dot1q[0], u.ipv4[0], u.udp[0], u.vxlan[0], u.eth[1], u.ipv4[1], u.tcp[0], u.data[0]});
+    u.toh.max_plen = 1500;
+    u.toh.min_plen = 64;
+    if (~u.corpus_open ("log/corpus_test", `SEED, "test"))
+    begin // {
+        $display("%0t : ERROR   : TEST      : Corpus not found for replay", $time);
+        err++;
+    end // }
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        u.corpus_get (u_pkt, hit);
+        if (~hit)
+            break;
+        num_hit++;
+        if (u_pkt != gen_q[i])
+        begin // {
+            $display("%0t : ERROR   : TEST      : Replayed Pkt %0d mismatch", $time, i+1);
+            err++;
+        end // }
+        // repack from unpacked hdrs
+        u.pack_hdr (p_pkt);
+        if (p_pkt != gen_q[i])
+        begin // {
+            $display("%0t : ERROR   : TEST      : Repacked Pkt %0d mismatch", $time, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Replayed Pkt %0d", $time, i+1);
+    end // }
+    u.corpus_get (u_pkt, hit);
+    if ((num_hit != `NUM_PKTS) | hit)
+    begin // {
+        $display("%0t : ERROR   : TEST      : %0d pkts replayed, expected %0d", $time, num_hit, `NUM_PKTS);
+        err++;
+    end // }
+    u.corpus_close ();
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Corpus Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Corpus Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
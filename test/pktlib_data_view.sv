@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies data_view unpack. Each pkt is randomized and packed,
+// then SMART_UNPACKed with data_view by a second pktlib, which repacks it.
+// Repacked pkt and fetched payload are compared with the original pkt.
+// Field map (diff_hdr) must leave payload as view.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u;
+  bit [7:0]      p_pkt [], u_pkt []; 
+  pktlib_diff_t  diff_q [$];
+  int            i, err;
+
+  initial
+  begin // {
+    u = new();
+    u.data_view = 1'b1;
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%4) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[0], p.tcp[0], p.data[0]});
+            3 : p.cfg_hdr ('{p.eth[0], p.mpls[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // unpack with payload left as view, repack (fetches view)
+        u.unpack_hdr (p_pkt, SMART_UNPACK);
+        if (u.data[0].is_view == 1'b0)
+        begin // {
+            $display("%0t : ERROR   : TEST      : data[0] not a view after unpack for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+        u.diff_hdr (u, diff_q);
+        if ((u.data[0].is_view == 1'b0) | (diff_q.size != 0))
+        begin // {
+            $display("%0t : ERROR   : TEST      : data[0] view fetched or %0d diffs by diff_hdr for Pkt %0d", $time, diff_q.size, i+1);
+            err++;
+        end // }
+        u.pack_hdr (u_pkt);
+        if (u_pkt != p_pkt)
+        begin // {
+            $display("%0t : ERROR   : TEST      : Repacked pkt mismatch for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+
+        // fetched payload must be same as data bytes of pkt
+        u.unpack_hdr (p_pkt, SMART_UNPACK);
+        u.fetch_views ();
+        if (u.data[0].data.size != u.data[0].data_len)
+        begin // {
+            $display("%0t : ERROR   : TEST      : data size %0d, data_len %0d for Pkt %0d", $time, u.data[0].data.size, u.data[0].data_len, i+1);
+            err++;
+        end // }
+        foreach (u.data[0].data[ls])
+        begin // {
+            if (u.data[0].data[ls] != p_pkt[u.data[0].start_off + ls])
+            begin // {
+                $display("%0t : ERROR   : TEST      : data[%0d] mismatch for Pkt %0d", $time, ls, i+1);
+                err++;
+                break;
+            end // }
+        end // }
+        $display("%0t : INFO    : TEST      : Data View Pkt %0d", $time, i+1);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Data View Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Data View Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
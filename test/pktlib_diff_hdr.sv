@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies diff_hdr. Each pkt is randomized and packed, then
+// unpacked as is and with ttl of ipv4[0] flipped. Same pkts must give no
+// diff, flipped one must give a diff for ttl.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u, v;
+  bit [7:0]      p_pkt [], c_pkt []; 
+  pktlib_diff_t  diff_q [$];
+  int            i, ttl_off, err;
+  bit            got_ttl;
+
+  initial
+  begin // {
+    u = new();
+    v = new();
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%3) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.mpls[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // same pkt, no diff
+        u.unpack_hdr (p_pkt, SMART_UNPACK);
+        v.unpack_hdr (p_pkt, SMART_UNPACK);
+        u.diff_hdr (v, diff_q);
+        p.diff_hdr (u, diff_q);
+        if (diff_q.size != 0)
+        begin // {
+            $display("%0t : ERROR   : TEST      : %0d diffs for same Pkt %0d", $time, diff_q.size, i+1);
+            err++;
+        end // }
+
+        // flip ttl, diff must point to it
+        c_pkt          = p_pkt;
+        ttl_off        = p.ipv4[0].start_off + 8;
+        c_pkt[ttl_off] = ~c_pkt[ttl_off];
+        v.unpack_hdr (c_pkt, SMART_UNPACK);
+        u.diff_hdr (v, diff_q);
+        got_ttl = 1'b0;
+        foreach (diff_q[ls])
+        begin // {
+            if ((diff_q[ls].hid == IPV4_HID) & (diff_q[ls].fld_off == ttl_off*8) & (diff_q[ls].fld_sz == 8) &
+                (diff_q[ls].exp == p_pkt[ttl_off]) & (diff_q[ls].act == c_pkt[ttl_off]))
+                got_ttl = 1'b1;
+        end // }
+        if (~got_ttl)
+        begin // {
+            $display("%0t : ERROR   : TEST      : ttl diff not found for Pkt %0d", $time, i+1);
+            foreach (diff_q[ls])
+                $display("%0t : ERROR   : TEST      :   %0s", $time, u.diff_to_string (diff_q[ls]));
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Diff Hdr Pkt %0d", $time, i+1);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Diff Hdr Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Diff Hdr Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+// This test verifies compares under DSP_ON_ERR display policy. Each pkt is
+// randomized and packed, then compared against itself and against a copy
+// with ttl of ipv4[0] flipped, with compare_pkt and with compare_hdr. Same
+// pkts must give no err, flipped one must give err (and get displayed).
+// Unpacks done inside compare_pkt must not be numbered for display policy.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 20
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u, v;
+  bit [7:0]      p_pkt [], c_pkt [];
+  int            i, ttl_off, err, cmp_err, pkt_cnt;
+
+  initial
+  begin // {
+    pktlib_display_class::set_dsp_policy (DSP_ON_ERR);
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        u = new();
+        v = new();
+
+        // configure different hdrs for this packet
+        case (i%2) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+        endcase // }
+
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // same pkt, no err
+        cmp_err = 0;
+        p.compare_pkt (p_pkt, p_pkt, cmp_err);
+        u.unpack_hdr  (p_pkt, SMART_UNPACK);
+        v.unpack_hdr  (p_pkt, SMART_UNPACK);
+        u.compare_hdr (v, cmp_err);
+        if (cmp_err != 0)
+        begin // {
+            $display("%0t : ERROR   : TEST      : %0d errs for same Pkt %0d", $time, cmp_err, i+1);
+            err++;
+        end // }
+
+        // flip ttl, both compares must flag it
+        c_pkt          = p_pkt;
+        ttl_off        = p.ipv4[0].start_off + 8;
+        c_pkt[ttl_off] = ~c_pkt[ttl_off];
+        cmp_err        = 0;
+        pkt_cnt        = pktlib_display_class::dsp_pkt_cnt;
+        p.compare_pkt (p_pkt, c_pkt, cmp_err);
+        if (cmp_err != 1)
+        begin // {
+            $display("%0t : ERROR   : TEST      : compare_pkt missed flipped ttl for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+        if (pktlib_display_class::dsp_pkt_cnt != pkt_cnt)
+        begin // {
+            $display("%0t : ERROR   : TEST      : compare_pkt numbered %0d pkts for Pkt %0d", $time, pktlib_display_class::dsp_pkt_cnt - pkt_cnt, i+1);
+            err++;
+        end // }
+        cmp_err = 0;
+        v.unpack_hdr  (c_pkt, SMART_UNPACK);
+        u.compare_hdr (v, cmp_err);
+        if (cmp_err != 1)
+        begin // {
+            $display("%0t : ERROR   : TEST      : compare_hdr missed flipped ttl for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Dsp On Err Pkt %0d", $time, i+1);
+    end // }
+    pktlib_display_class::set_dsp_policy ();
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Dsp On Err Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Dsp On Err Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies fast_randomize. Each pkt is randomized without the
+// solver, then randomize (null) checks all the hdr constraints hold and
+// pkt is unpacked/compared with a smart unpack of itself.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class p, u;
+  bit [7:0]    p_pkt [], u_pkt []; 
+  int          i, err;
+
+  initial
+  begin // {
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%5) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[0], p.tcp[0], p.data[0]});
+            3 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.dot1q[1], p.ipv6[0], p.tcp[0], p.data[0]});
+            4 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]}); // gre uses solver
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen         = 1500;
+        p.toh.min_plen         = 64;
+        p.toh.plen_multiple_of = 4;
+
+        // randomize pktlib without solver
+        if (~p.fast_randomize ())
+        begin // {
+            $display("%0t : ERROR   : TEST      : fast_randomize failed for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+
+        // all the hdr constraints must hold for fast_randomize values
+        if (~p.randomize (null))
+        begin // {
+            $display("%0t : ERROR   : TEST      : Constraints failed for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+
+        // pack all the hdrs to pkt
+        p.pack_hdr (p_pkt);
+
+        // unpack to new pktlib and repack, pkt should not change
+        u = new();
+        u.unpack_hdr (p_pkt, SMART_UNPACK);
+        u.pack_hdr (u_pkt);
+
+        $display("%0t : INFO    : TEST      : Fast Randomize Pkt %0d", $time, i+1);
+        p.compare_pkt (p_pkt, u_pkt, err);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Fast Randomize Pkts Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Fast Randomize Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies get_flow_key. Outer/inner flow keys of each packed
+// pkt are compared with the ip/l4 hdrs which built it, and hash is
+// compared with flow_hash of the keys.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class      p, u;
+  bit [7:0]         p_pkt []; 
+  pktlib_flow_key_t outer, inner, exp_o, exp_i;
+  bit [63:0]        hash;
+  int               i, err;
+
+  initial
+  begin // {
+    u = new();
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet, ipv4 not fragmented
+        exp_o = '0;
+        exp_i = '0;
+        case (i%3) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[1], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.tcp[0], p.data[0]});
+        endcase // }
+        p.randomize () with { ipv4[0].frag_offset == 0; ipv4[1].frag_offset == 0; };
+        p.pack_hdr (p_pkt);
+
+        // expected keys from hdrs
+        case (i%3) // {
+            0 : 
+            begin // {
+                exp_o = '{4, p.ipv4[0].ip_sa, p.ipv4[0].ip_da, p.ipv4[0].protocol, p.udp[0].src_prt, p.udp[0].dst_prt};
+            end // }
+            1 : 
+            begin // {
+                exp_o = '{4, p.ipv4[0].ip_sa, p.ipv4[0].ip_da, p.ipv4[0].protocol, p.udp[0].src_prt, p.udp[0].dst_prt};
+                exp_i = '{4, p.ipv4[1].ip_sa, p.ipv4[1].ip_da, p.ipv4[1].protocol, p.tcp[0].src_prt, p.tcp[0].dst_prt};
+            end // }
+            2 : 
+            begin // {
+                exp_o = '{6, p.ipv6[0].ip6_sa, p.ipv6[0].ip6_da, p.ipv6[0].protocol, p.tcp[0].src_prt, p.tcp[0].dst_prt};
+            end // }
+        endcase // }
+
+        hash = u.get_flow_key (p_pkt, outer, inner);
+        if ((outer != exp_o) | (inner != exp_i) | (hash != pktlib_main_class::flow_hash (exp_o, exp_i)))
+        begin // {
+            $display("%0t : ERROR   : TEST      : Flow key mismatch for Pkt %0d", $time, i+1);
+            $display("    outer exp %h act %h", exp_o, outer);
+            $display("    inner exp %h act %h", exp_i, inner);
+            err++;
+        end // }
+        else
+            $display("%0t : INFO    : TEST      : Flow Key Pkt %0d hash %h", $time, i+1, hash);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Flow Key Pkts Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Flow Key Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+// This test verifies SMART_UNPACK with parse graph changes. vxlan port is
+// moved to 4789 on both pktlibs, so old vxlan port 8472 must unpack as
+// data. otv is packed on port 9999 and unpacker learns it only through
+// add_transition. Unpacked hdr stack and repacked pkt must match.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 60
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u;
+  bit [7:0]      p_pkt [], u_pkt [];
+  int            i, err;
+
+  initial
+  begin // {
+    pktlib_parse_graph_class::add_transition (SEL_UDP_DST_PRT, 16'd9999, OTV_HID);
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlibs, vxlan port moved on both
+        p = new();
+        u = new();
+        p.udp[0].vxlan_udp_dst_prt = 16'd4789;
+        u.udp[0].vxlan_udp_dst_prt = 16'd4789;
+        p.udp[0].otv_udp_dst_prt   = 16'd9999;
+        p.udp[1].otv_udp_dst_prt   = 16'd9999;
+
+        // configure different hdrs for this packet
+        case (i%3) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[1], p.tcp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.otv[0], p.eth[1], p.ipv4[1], p.udp[1], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+        endcase // }
+
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib, data pkts on old vxlan port
+        if (i%3 == 2)
+            p.randomize with { udp[0].dst_prt == 16'd8472; };
+        else
+            p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // unpack, same hdrs and same pkt on repack
+        u.unpack_hdr (p_pkt, SMART_UNPACK);
+        if (u.first_hdr.hdr_stk.all_hdr.size != p.first_hdr.hdr_stk.all_hdr.size)
+        begin // {
+            $display("%0t : ERROR   : TEST      : %0d hdrs unpacked, expected %0d for Pkt %0d", $time,
+                     u.first_hdr.hdr_stk.all_hdr.size, p.first_hdr.hdr_stk.all_hdr.size, i+1);
+            err++;
+        end // }
+        else
+        begin // {
+            foreach (p.first_hdr.hdr_stk.all_hdr[ls])
+            begin // {
+                if (u.first_hdr.hdr_stk.all_hdr[ls].hid != p.first_hdr.hdr_stk.all_hdr[ls].hid)
+                begin // {
+                    $display("%0t : ERROR   : TEST      : hdr %0d unpacked as %0s, expected %0s for Pkt %0d", $time, ls,
+                             u.first_hdr.hdr_stk.all_hdr[ls].hdr_name, p.first_hdr.hdr_stk.all_hdr[ls].hdr_name, i+1);
+                    err++;
+                    break;
+                end // }
+            end // }
+        end // }
+        u.pack_hdr (u_pkt);
+        if (u_pkt != p_pkt)
+        begin // {
+            $display("%0t : ERROR   : TEST      : Repacked pkt mismatch for Pkt %0d", $time, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Parse Graph Pkt %0d", $time, i+1);
+    end // }
+    pktlib_parse_graph_class::reset_tbl ();
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Parse Graph Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Parse Graph Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
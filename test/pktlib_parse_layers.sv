@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies parse_layers. Each pkt is randomized and packed, then
+// flat layer list from a fresh pktlib is compared with the all_hdr of
+// the pktlib which built the pkt.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u;
+  bit [7:0]      p_pkt []; 
+  pktlib_layer_t layer_q [$];
+  hdr_class      h;
+  int            i, j, err;
+
+  initial
+  begin // {
+    u = new();
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%5) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[0], p.tcp[0], p.data[0]});
+            3 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.dot1q[1], p.ipv6[0], p.tcp[0], p.data[0]});
+            4 : p.cfg_hdr ('{p.eth[0], p.mpls[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 1500;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib
+        p.randomize ();
+        p.pack_hdr (p_pkt);
+
+        // flat parse, compare with the hdrs which built the pkt
+        u.parse_layers (p_pkt, layer_q);
+        j = 0;
+        foreach (p.first_hdr.hdr_stk.all_hdr[ls])
+        begin // {
+            h = p.first_hdr.hdr_stk.all_hdr[ls];
+            if ((h.hid == TOP_HID) | (h.hid == EOH_HID) | (h.hdr_len == 0))
+                continue;
+            if ((j >= layer_q.size) || (layer_q[j].hid       != h.hid)       ||
+                                       (layer_q[j].inst_no   != h.inst_no)   ||
+                                       (layer_q[j].start_off != h.start_off) ||
+                                       (layer_q[j].hdr_len   != h.hdr_len))
+            begin // {
+                $display("%0t : ERROR   : TEST      : Layer %0d (%0s) mismatch for Pkt %0d", $time, j, h.hdr_name, i+1);
+                err++;
+                break;
+            end // }
+            j++;
+        end // }
+        if (j != layer_q.size)
+        begin // {
+            $display("%0t : ERROR   : TEST      : %0d layers expected, got %0d for Pkt %0d", $time, j, layer_q.size, i+1);
+            err++;
+        end // }
+
+        // max_depth stops after first 2 layers
+        u.parse_layers (p_pkt, layer_q, 2);
+        if (layer_q.size != 2)
+        begin // {
+            $display("%0t : ERROR   : TEST      : max_depth 2 gave %0d layers for Pkt %0d", $time, layer_q.size, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Parse Layers Pkt %0d", $time, i+1);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Parse Layers Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Parse Layers Pkts Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
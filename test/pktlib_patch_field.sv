@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies patch_field. Each pkt is packed once, few fields are
+// patched in place and result is compared with full repack of same hdrs.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class p;
+  bit [7:0]    p_pkt [], r_pkt []; 
+  int          i, err;
+
+  initial
+  begin // {
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%4) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[1], p.tcp[0], p.data[0]});
+            3 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.tcp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 300;
+        p.toh.min_plen = 64;
+
+        // randomize pktlib
+        p.randomize with  
+        {
+          data[0].data_len < 40;
+        };
+        
+        // pack all the hdrs to pkt
+        p.pack_hdr (p_pkt);
+        
+        // patch few fields in place
+        p.patch_field (p.eth[0],  "da", $urandom);
+        if (i%4 == 2)
+            p.patch_field (p.ipv6[0], "ip6_sa", {$urandom, $urandom, $urandom, $urandom});
+        else
+            p.patch_field (p.ipv4[0], "ttl", $urandom);
+        if (i%2)
+            p.patch_field (p.tcp[0], "seq_number", $urandom);
+        else
+            p.patch_field (p.udp[0], "src_prt", $urandom);
+        p_pkt = p.pkt;
+
+        // repack with patched fields, checksums and crc get recalculated
+        p.pack_hdr (r_pkt);
+
+        $display("%0t : INFO    : TEST      : Patch Pkt %0d", $time, i+1);
+        p.compare_pkt (p_pkt, r_pkt, err);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Patched Pkts Miscompare", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Patched Pkts Compare", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
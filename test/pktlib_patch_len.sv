@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// ----------------------------------------------------------------------
+// This test verifies L4 checksum fix up by patch_field for a length patch.
+// Each pkt is packed once, total_length of ipv4[0] is patched (also below
+// ihl*4, so pseudo hdr length wraps) and tcp checksum is compared with
+// full recompute over pseudo hdr and tcp segment of patched pkt.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p;
+  bit [7:0]      c_pkt [];
+  bit [15:0]     new_len, l4_len, exp_chksm, act_chksm;
+  bit [31:0]     p_sum;
+  int            i, tcp_off, err;
+
+  initial
+  begin // {
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // new pktlib
+        p = new();
+        
+        // configure different hdrs for this packet
+        case (i%2) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.tcp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+        endcase // }
+        
+        // set max/min packet length
+        p.toh.max_plen = 300;
+        p.toh.min_plen = 64;
+
+        // randomize and pack pktlib, no pad so checksum covers till crc
+        p.randomize with  
+        {
+          data[0].data_len inside {[20:100]};
+        };
+        p.pack_hdr (c_pkt);
+
+        // patch length, every 4th one below ihl*4
+        if (i%4 == 3)
+            new_len = $urandom_range (p.ipv4[0].ihl*4 - 1, 0);
+        else
+            new_len = p.ipv4[0].total_length + $urandom_range (8, 1);
+        p.patch_field (p.ipv4[0], "total_length", new_len);
+
+        // full recompute of tcp checksum
+        c_pkt       = p.pkt;
+        tcp_off     = p.tcp[0].start_off;
+        act_chksm   = {c_pkt[tcp_off+16], c_pkt[tcp_off+17]};
+        c_pkt[tcp_off+16] = 8'h0;
+        c_pkt[tcp_off+17] = 8'h0;
+        l4_len      = new_len - (p.ipv4[0].ihl*4);
+        p_sum       = p.ipv4[0].ip_sa[31:16] + p.ipv4[0].ip_sa[15:0] +
+                      p.ipv4[0].ip_da[31:16] + p.ipv4[0].ip_da[15:0] +
+                      p.ipv4[0].protocol + l4_len;
+        exp_chksm   = p.tcp[0].crc_chksm.chksm16_slice (c_pkt, tcp_off, c_pkt.size - p.toh.get_crc_sz () - tcp_off, 0, 0, p_sum);
+        if (act_chksm != exp_chksm)
+        begin // {
+            $display("%0t : ERROR   : TEST      : tcp checksum 'h%0h, expected 'h%0h, total_length %0d for Pkt %0d",
+                     $time, act_chksm, exp_chksm, new_len, i+1);
+            err++;
+        end // }
+        $display("%0t : INFO    : TEST      : Patch Len Pkt %0d", $time, i+1);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Patched Len Checksums Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Patched Len Checksums Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
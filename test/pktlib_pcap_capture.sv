@@ -32,6 +32,14 @@ program my_test (); // {
   bit [63:0]   sm_time;
   int          i = 0;
 
+  // task to get one pkt from phandle. Automatic, so PROF_BEGIN opens a
+  // stage on every call
+  task automatic get_pkt (); // {
+    `PROF_BEGIN
+    pv_get_pkt (phandle, pkt_len, pkt, sm_time);
+    `PROF_DPI ("pv_get_pkt", "pcap")
+  endtask : get_pkt // }
+
   initial
   begin // {
     // register pcap handle
@@ -41,7 +49,7 @@ program my_test (); // {
     pv_open (phandle, "pcap_log/sample-capture.pcap", 1);
 
     // get first pkt from phandle
-    pv_get_pkt (phandle, pkt_len, pkt, sm_time);
+    get_pkt ();
     while (pkt_len != 0)
     begin // {
 	// new pktlib for unpack
@@ -57,7 +65,7 @@ program my_test (); // {
         i++;
 
         // get all pkt from phandle
-        pv_get_pkt (phandle, pkt_len, pkt, sm_time);
+        get_pkt ();
     end // }
     // end simulation
     $finish ();
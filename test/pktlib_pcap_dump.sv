@@ -31,6 +31,14 @@ program my_test (); // {
   bit [7:0]    pkt [];
   int          i;
 
+  // task to dump pkt to phandle. Automatic, so PROF_BEGIN opens a stage on
+  // every call
+  task automatic dump_pkt (); // {
+    `PROF_BEGIN
+    pv_dump_pkt (phandle, pkt.size, pkt, $time);
+    `PROF_DPI ("pv_dump_pkt", "pcap")
+  endtask : dump_pkt // }
+
   initial
   begin // {
     // register pcap handle
@@ -84,7 +92,7 @@ program my_test (); // {
         p.display_pkt (pkt);
          
         // dump pcap
-        pv_dump_pkt (phandle, pkt.size, pkt, $time);
+        dump_pkt ();
     end // }
     // end simulation
     pv_shutdown (phandle);
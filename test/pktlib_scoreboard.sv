@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies pktlib_scoreboard_class. Expected pkts of 4 queues
+// are received shuffled, with one pkt corrupted in payload, one in ip_sa
+// (flow key, diffed with oldest expected pkt of its qid), one dropped and
+// one extra. report should give exactly those 4 errors.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 100
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class            p;
+  pktlib_scoreboard_class sb;
+  pktlib_sb_entry_t       pkt_db [`NUM_PKTS];
+  int                     idx_q [$];
+  bit [7:0]               p_pkt []; 
+  int                     i, err;
+
+  initial
+  begin // {
+    sb = new ("pkt_sb", SB_FLOW_HASH);
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        p = new();
+        case (i%2) // {
+            0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+            1 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.tcp[0], p.data[0]});
+        endcase // }
+        p.toh.max_plen = 256;
+        p.randomize () with { ipv4[0].frag_offset == 0; };
+        p.pack_hdr (p_pkt);
+        sb.add_exp (p_pkt, i%4);
+        pkt_db[i].pkt = p_pkt;
+        idx_q.push_back (i);
+    end // }
+
+    // corrupt ip_sa of first pkt (oldest on qid 0) and payload of second,
+    // drop the last one and shuffle
+    pkt_db[0].pkt[26] ^= 8'hff;
+    pkt_db[1].pkt[pkt_db[1].pkt.size-5] ^= 8'hff;
+    idx_q.delete (idx_q.size-1);
+    idx_q.shuffle ();
+
+    // receive
+    foreach (idx_q[ls])
+        sb.chk_rcv (pkt_db[idx_q[ls]].pkt, idx_q[ls]%4);
+
+    // extra pkt
+    p = new();
+    p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+    p.randomize ();
+    p.pack_hdr (p_pkt);
+    sb.chk_rcv (p_pkt, 0);
+
+    err = sb.report ();
+    if ((err != 4) | (sb.num_mismatch != 2) | (sb.num_unexp != 1))
+        $display("%0t : ERROR   : TEST      : Scoreboard gave %0d errors, expected 4", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : Scoreboard Test Passed", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
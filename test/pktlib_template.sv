@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test verifies pkt template. Pkt is randomized and packed once, 
+// variants are generated by nxt_tmpl_pkt and compared with full repack.
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 1000
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class p;
+  bit [7:0]    p_pkt [], r_pkt []; 
+  int          i, err;
+
+  initial
+  begin // {
+    // new pktlib
+    p = new();
+
+    // configure hdrs of template
+    p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.udp[0], p.data[0]});
+
+    // set max/min packet length
+    p.toh.max_plen = 300;
+    p.toh.min_plen = 64;
+
+    // randomize and pack template once
+    p.randomize with  
+    {
+      data[0].data_len < 40;
+    };
+    p.pack_hdr (p_pkt);
+
+    // fields to vary for every pkt
+    p.add_fld_var (p.udp[0],   "src_prt", FLD_INCR, 16'hfff0, .step(3));
+    p.add_fld_var (p.udp[0],   "dst_prt", FLD_DECR, 16'h0010, .min_val(16'h8), .max_val(16'h20));
+    p.add_fld_var (p.ipv4[0],  "ip_da",   FLD_RND,  .min_val(32'h0a000000), .max_val(32'h0a0000ff));
+    p.add_fld_var (p.dot1q[0], "vlan",    FLD_LIST, .val_list('{12'h1, 12'h64, 12'hffe}));
+
+    for (i = 0; i < `NUM_PKTS; i++)
+    begin // {
+        // patch next variant, reload hdr fields for repack below
+        p.nxt_tmpl_pkt (p_pkt, 1'b1);
+
+        // repack with patched fields, checksums and crc get recalculated
+        p.pack_hdr (r_pkt);
+
+        $display("%0t : INFO    : TEST      : Template Pkt %0d", $time, i+1);
+        p.compare_pkt (p_pkt, r_pkt, err);
+    end // }
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Template Pkts Miscompare", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All Template Pkts Compare", $time);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }
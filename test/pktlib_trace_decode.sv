@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2011, Sachin Gandhi
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    * Neither the name of the author nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+// This test writes a binary pkt trace of packed/unpacked/compared pkts
+// and decodes it back with full field display. Run with +trace_file=<f>
+// to only decode an existing trace, +first=<n> +last=<n> select records,
+// +no_crc if traced pkts had no crc (toh.cal_n_add_crc = 0).
+// Needs +define+PKTLIB_DPI_TRACE and hdr_db/include/trace/trace_dpi.c
+// ----------------------------------------------------------------------
+
+`define NUM_PKTS 20
+
+program my_test (); // {
+
+  // include files
+  `include "pktlib_class.sv"
+
+  // local defines
+  pktlib_class   p, u;
+  bit [7:0]      p_pkt [], t_pkt []; 
+  string         trace_file;
+  int            i, h, len, first, last, num_rec, err;
+  longint        hdr_sig, sim_time;
+  int            pid, pnum, path, drv_ctrl, pkt_format, status;
+  bit            no_crc;
+  string         status_name [] = '{"PACK", "UNPACK", "CMP_PASS", "CMP_FAIL"};
+
+  initial
+  begin // {
+    first  = 0;
+    last   = 'h7fff_ffff;
+    no_crc = $test$plusargs ("no_crc");
+    void'($value$plusargs ("first=%d", first));
+    void'($value$plusargs ("last=%d",  last));
+    if (!$value$plusargs ("trace_file=%s", trace_file))
+    begin // {
+        // write trace of few pkts
+        trace_file = "log/pktlib_trace.bin";
+        if (!pktlib_class::trace_open (trace_file))
+            $finish ();
+        u = new();
+        for (i = 0; i < `NUM_PKTS; i++)
+        begin // {
+            p = new();
+            case (i%4) // {
+                0 : p.cfg_hdr ('{p.eth[0], p.ipv4[0], p.udp[0], p.data[0]});
+                1 : p.cfg_hdr ('{p.eth[0], p.dot1q[0], p.ipv4[0], p.tcp[0], p.data[0]});
+                2 : p.cfg_hdr ('{p.eth[0], p.ipv6[0], p.udp[0], p.vxlan[0], p.eth[1], p.ipv4[0], p.tcp[0], p.data[0]});
+                3 : p.cfg_hdr ('{p.eth[0], p.mpls[0], p.ipv4[0], p.gre[0], p.ipv4[1], p.udp[0], p.data[0]});
+            endcase // }
+            p.toh.max_plen = 256;
+            p.toh.min_plen = 64;
+            p.pnum         = i%2;
+            p.randomize ();
+            p.pack_hdr (p_pkt);
+            u.unpack_hdr (p_pkt, SMART_UNPACK);
+            u.compare_pkt (p);
+        end // }
+        pktlib_class::trace_close ();
+    end // }
+
+    // decode trace
+    h = pv_trace_open (trace_file, 1);
+    if (h < 0)
+    begin // {
+        $display("%0t : ERROR   : TEST      : Can't open trace %0s", $time, trace_file);
+        $finish ();
+    end // }
+    p = new();
+    p.toh.cal_n_add_crc = ~no_crc;
+    while (1)
+    begin // {
+        len = pv_trace_read (h, hdr_sig, sim_time, pid, pnum, path, drv_ctrl, pkt_format, status);
+        if ((len < 0) | (num_rec >= last))
+            break;
+        num_rec++;
+        if (num_rec <= first)
+            continue;
+        t_pkt = new [len];
+        pv_trace_get_pkt (h, t_pkt);
+        $display("%0t : INFO    : TEST      : Trace Pkt %0d %0s time %0d pid %0d pnum %0d hdr_sig %h",
+                 $time, num_rec, (status < 4) ? status_name[status] : "?", sim_time, pid, pnum, hdr_sig);
+        p.unpack_hdr (t_pkt, SMART_UNPACK,, pkt_format);
+        p.display_hdr_pkt ();
+        if (p.get_hdr_sig () != hdr_sig)
+        begin // {
+            $display("%0t : ERROR   : TEST      : hdr_sig mismatch for Trace Pkt %0d", $time, num_rec);
+            err++;
+        end // }
+        if (status == TRC_CMP_FAIL)
+            err++;
+    end // }
+    pv_trace_close (h);
+    if (err)
+        $display("%0t : ERROR   : TEST      : %0d Trace Checks Failed", $time, err);
+    else
+        $display("%0t : INFO    : TEST      : All %0d Trace Pkts Passed", $time, num_rec);
+    // end simulation
+    $finish ();
+  end // }
+
+endprogram : my_test // }